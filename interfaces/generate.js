@@ -1,132 +1,310 @@
+/**
+ * Generates modules from the kernel descriptions in ./kernels.
+ * Every description lists its methods once, from that the scalar
+ * exports and the js bridge are emitted. The strided array variants
+ * are added by rollup/batch.js, like for the handwritten modules, with
+ * a SIMD path for the packed case of the componentwise methods (only
+ * compiled with a simd128 capable toolchain).
+ *
+ * Method kinds:
+ *  create        malloc'ed vector of the given values
+ *  clone         malloc'ed copy of a
+ *  fromValues    malloc'ed vector of the scalar params
+ *  componentwise out[i] = expr for every component, "[i]" is substituted.
+ *                simd is the same expression on v128_t's, "$name"
+ *                refers to the vector of the param name
+ *  reduce        returns wrap(expr + expr ...), an optional temp is
+ *                bound per component and referenced as "t" in expr
+ *  custom        literal body
+ *  alias         forwards to target
+ *
+ * Params are written as "type name doc", "type [name] doc" for optional ones,
+ * returns as "type doc".
+ *
+ * Only vectors can be described: size is the component count, storage
+ * is VEC_SIZE_<size> floats and the array variants stride over whole
+ * vectors. Matrices and quaternions (mat2, mat2d, mat3, quat) are
+ * still written by hand
+ */
 const fs = require("fs");
-const acorn = require("acorn");
-let walker = require("acorn/dist/walk");
+const path = require("path");
+const batch = require("../rollup/batch");
 
-let options = {
-  ecmaVersion: 7,
-  allowImportExportEverywhere: true
+let kernelDir = __dirname + "/kernels/";
+let sourceDir = __dirname + "/../src/";
+let cDir = sourceDir + "gl-matrix/";
+
+const COMPONENTS = ["x", "y", "z", "w"];
+
+const C_TYPES = {
+  Number: "float",
+  Boolean: "int"
 };
 
-function findReturn(node) {
-  let ret = null;
-  walker.simple(node, {
-    ReturnStatement(child) {
-      ret = child;
-    }
-  });
-  return ret;
+function parseParam(str) {
+  let parts = str.split(" ");
+  let type = parts[0];
+  let name = parts[1];
+  let optional = name[0] === "[";
+  if (optional) name = name.slice(1, -1);
+  return {
+    type,
+    name,
+    optional,
+    doc: parts.slice(2).join(" "),
+    ctype: C_TYPES[type] || "float *"
+  };
 };
 
-function findAllocation(node) {
-  let ret = null;
-  walker.simple(node, {
-    NewExpression(child) {
-      let callee = child.callee;
-      let args = child.arguments;
-      let object = callee.object;
-      let property = callee.property;
-      let computed = callee.computed;
-      if (
-        !computed &&
-        object.type === "Identifier" &&
-        object.name === "glMatrix" &&
-        property.type === "Identifier" &&
-        property.name === "ARRAY_TYPE"
-      ) {
-        let size = args[0];
-        if (
-          size &&
-          size.type === "Literal"
-        ) {
-          ret = size.value;
-        }
-      }
-    }
-  });
-  return ret;
+function parseReturns(str) {
+  let parts = str.split(" ");
+  let type = parts[0];
+  return {
+    type,
+    doc: parts.slice(1).join(" "),
+    ctype: C_TYPES[type] || "float *"
+  };
 };
 
-function getReturnType(node) {
-  let type = node.type;
-  if (type === "Identifier") return "out";
-  return type;
+function emitDecl(ctype, name) {
+  return ctype.endsWith("*") ? `${ctype}${name}` : `${ctype} ${name}`;
 };
 
-function getExport(node) {
-  let decl = node.declaration;
-  if (decl.type === "FunctionDeclaration") {
-    let declName = decl.id.name;
-    let ret = findReturn(node);
-    let retType = getReturnType(ret.argument);
-    let allocation = findAllocation(node);
-    let result = {
-      id: declName,
-      returns: retType
-    };
-    if (allocation) result.allocation = allocation;
-    return result;
-  }
+function emitComment(doc, params, returns) {
+  let out = [`/**`, ` * ${doc}`];
+  if (params.length || returns) out.push(` *`);
+  params.map(param => {
+    let name = param.optional ? `[${param.name}]` : param.name;
+    out.push(` * @param {${param.type}} ${name} ${param.doc}`);
+  });
+  if (returns) out.push(` * @returns {${returns.type}} ${returns.doc}`);
+  out.push(` */`);
+  return out.join("\n");
 };
 
-function isCustomInterfaceRequired(moduleInterface) {
-  return (
-    (moduleInterface.returns !== "out") ||
-    (moduleInterface.allocation !== void 0)
-  );
+function emitFunction(kernel, method, params, returns, body) {
+  let ns = kernel.name;
+  let signature = params.map(param => emitDecl(param.ctype, param.name)).join(", ");
+  return [
+    emitComment(method.doc, params, returns),
+    `export ${emitDecl(returns.ctype, "")}${ns}(${method.name})(${signature}) {`,
+    ...body.map(line => "  " + line),
+    `};`
+  ].join("\n");
 };
 
-function processComment(comment) {
-  let arg = {
-    arguments: [],
-    returns: null
-  };
-  let split = comment.split("\n");
-  split.map(line => {
-    if (line.match("@param")) {
-      let start = line.indexOf("{") + 1;
-      let end = line.lastIndexOf("}");
-      let type = line.substr(start, end - start);
+function substitute(expr, index) {
+  return expr.replace(/\[i\]/g, `[${index}]`);
+};
+
+/**
+ * Normalizes a method into params, returns and body,
+ * these are used for both the export and its aliases
+ */
+function describe(kernel, method) {
+  let ns = kernel.name;
+  let size = kernel.size;
+  let indices = Array.from({ length: size }, (v, ii) => ii);
+  let vector = { type: ns, ctype: "float *" };
+  let out = Object.assign({ name: "out", doc: "the receiving vector" }, vector);
+  let params = (method.params || []).map(parseParam);
+  switch (method.kind) {
+    case "create":
+    case "clone":
+    case "fromValues": {
+      if (method.kind === "clone") params = [Object.assign({ name: "a", doc: "vector to clone" }, vector)];
+      let values = (
+        method.kind === "create" ? method.values :
+        method.kind === "clone" ? indices.map(ii => `a[${ii}]`) :
+        params.map(param => param.name)
+      );
+      return {
+        params,
+        returns: Object.assign({}, vector, { doc: `a new ${size}D vector` }),
+        body: [
+          `float *out = malloc(VEC_SIZE_${size} * sizeof(*out));`,
+          ...values.map((value, ii) => `out[${ii}] = ${value};`),
+          `return out;`
+        ]
+      };
     }
-    else if (line.match("@return")) {
-      let start = line.indexOf("{") + 1;
-      let end = line.lastIndexOf("}");
-      let type = line.substr(start, end - start);
-      console.log(type);
+    case "componentwise":
+      return {
+        params: [out].concat(params),
+        returns: Object.assign({}, vector, { doc: "out" }),
+        body: indices.map(ii => `out[${ii}] = ${substitute(method.expr, ii)};`).concat(`return out;`)
+      };
+    case "reduce": {
+      let body = [];
+      let terms = indices.map(ii => {
+        if (!method.temp) return substitute(method.expr, ii);
+        body.push(`float ${COMPONENTS[ii]} = ${substitute(method.temp, ii)};`);
+        return method.expr.replace(/\bt\b/g, COMPONENTS[ii]);
+      });
+      let sum = terms.join(" + ");
+      body.push(`return ${method.wrap ? method.wrap.replace("%", sum) : sum};`);
+      return { params, returns: parseReturns(method.returns), body };
     }
-  });
-  return arg;
+    case "custom":
+      return { params, returns: parseReturns(method.returns), body: method.body };
+    case "alias": {
+      let target = kernel.methods.filter(other => other.name === method.target)[0];
+      let desc = describe(kernel, target);
+      let args = desc.params.map(param => param.name).join(", ");
+      return {
+        params: desc.params,
+        returns: desc.returns,
+        body: [`return ${ns}(${method.target})(${args});`]
+      };
+    }
+  };
+  throw new Error(`Unknown kind ${method.kind} of ${ns}.${method.name}`);
 };
 
-module.exports = function(source) {
+function emitMethod(kernel, method) {
+  let desc = describe(kernel, method);
+  if (method.kind !== "alias") return emitFunction(kernel, method, desc.params, desc.returns, desc.body);
+  let signature = desc.params.map(param => emitDecl(param.ctype, param.name)).join(", ");
+  return [
+    `/**`,
+    ` * Alias for {@link ${kernel.name}.${method.target}}`,
+    ` * @function`,
+    ` */`,
+    `export ${emitDecl(desc.returns.ctype, "")}${kernel.name}(${method.name})(${signature}) {`,
+    ...desc.body.map(line => "  " + line),
+    `};`
+  ].join("\n");
+};
 
-  let cmnts = [];
-  options.onComment = cmnts;
+/**
+ * The packed path of the array variants loads 4 floats of every vector
+ * operand at once, scalars are splatted. Only used for componentwise
+ * methods with a simd expression whose pointer params are all vectors
+ */
+function emitSimd(kernel, decl) {
+  let size = kernel.size;
+  let method = kernel.methods.filter(other => other.name === decl.name)[0];
+  let rest = decl.params.slice(2);
+  if (!method || !method.simd || 4 % size) return [];
+  if (rest.some(param => param.pointer && !batch.isStrided(decl, param))) return [];
+  let vectors = rest.filter(param => param.pointer);
+  let setup = rest.filter(param => !param.pointer).map(param => {
+    return `    v128_t v${param.name} = wasm_f32x4_splat(${param.name});`;
+  });
+  let loads = vectors.map(param => `      v128_t v${param.name} = wasm_v128_load(${param.name} + jj);`);
+  let expr = method.simd.replace(/\$(\w+)/g, "v$1");
+  let args = ["out + jj", "a + jj"].concat(rest.map(param => param.pointer ? `${param.name} + jj` : param.name)).join(", ");
+  return [
+    `#ifdef __wasm_simd128__`,
+    `  if (stride == VEC_SIZE_${size}) {`,
+    ...setup,
+    `    int end = offset + count * VEC_SIZE_${size};`,
+    `    int jj = offset;`,
+    `    for (; jj + 4 <= end; jj += 4) {`,
+    `      v128_t va = wasm_v128_load(a + jj);`,
+    ...loads,
+    `      wasm_v128_store(out + jj, ${expr});`,
+    `    };`,
+    `    for (; jj < end; jj += VEC_SIZE_${size}) ${kernel.name}(${decl.name})(${args});`,
+    `    return out;`,
+    `  }`,
+    `#endif`
+  ];
+};
 
-  let ast = acorn.parse(source, options);
-  let program = ast;
+function emitSource(kernel, file) {
+  let ns = kernel.name;
+  let out = [
+    `// generated by interfaces/generate.js from interfaces/kernels/${file}`,
+    `#include <webassembly.h>`,
+    `#include <math.h>`,
+    `#include "common.h"`,
+    `#ifdef __wasm_simd128__`,
+    `#include <wasm_simd128.h>`,
+    `#endif`,
+    ``,
+    `#define ${ns}(x) ${ns}_##x`,
+    ``,
+    [
+      `/**`,
+      ` * Frees a ${ns}`,
+      ` */`,
+      `export float *${ns}(free)(float *a) {`,
+      `  free(a);`,
+      `  return NULL;`,
+      `};`
+    ].join("\n")
+  ];
+  kernel.methods.map(method => out.push("", emitMethod(kernel, method)));
+  // the array variants come from the same generator as vec3's and vec4's
+  return batch(out.join("\n") + "\n", {
+    sizes: { [ns]: `VEC_SIZE_${kernel.size}` },
+    packed: decl => emitSimd(kernel, decl)
+  });
+};
 
-  let table = {};
-  for (let ii = 0; ii < program.body.length; ++ii) {
-    let node = program.body[ii];
-    if (node.type === "ExportNamedDeclaration") {
-      let decl = getExport(node);
-      if (!decl) continue;
-      decl.specialInterface = isCustomInterfaceRequired(decl);
-      table[decl.id] = decl;
-    }
+function emitBridge(kernel) {
+  let ns = kernel.name;
+  let components = Array.from({ length: kernel.size }, (v, ii) => `\${ view[${ii}] }`).join(", ");
+  return `// generated by interfaces/generate.js
+/**
+ * The following methods need to be bridged
+ * within js which results in some overhead
+ */
+export default function(module, memory) {
+  // @str
+  module.str = function(address) {
+    let view = memory.F32.subarray(address >> 2, (address >> 2) + ${kernel.size});
+    return \`${ns}(${components})\`;
   };
-
-  let comments = [];
-  for (let ii = 0; ii < cmnts.length; ++ii) {
-    let comment = cmnts[ii].value;
-    if (
-      cmnts[ii].type === "Block" &&
-      (comment.match("@returns ") !== null || comment.match("@return ") !== null)
-    ) {
-      comments.push(processComment(comment));
-    }
+  // @view
+  module.view = function(address) {
+    return memory.F32.subarray(address >> 2, (address >> 2) + ${kernel.size});
+  };
+  // @exactEquals
+  let _exactEquals = module.exactEquals;
+  module.exactEquals = function(a, b) {
+    return !!_exactEquals(a, b);
   };
+  // @equals
+  let _equals = module.equals;
+  module.equals = function(a, b) {
+    return !!_equals(a, b);
+  };
+};
+`;
+};
 
-  return table;
+function emitIndex(kernels) {
+  let out = [`// generated by interfaces/generate.js`];
+  kernels.map(kernel => out.push(`import ${kernel.name}_bridge from "./gl-matrix/bridges/${kernel.name}.js";`));
+  out.push(``);
+  kernels.map(kernel => out.push(`export let ${kernel.name} = {};`));
+  out.push(``);
+  out.push(`export default [`);
+  out.push(kernels.map(kernel => `  { name: "${kernel.name}", module: ${kernel.name}, bridge: ${kernel.name}_bridge }`).join(",\n"));
+  out.push(`];`);
+  return out.join("\n") + "\n";
+};
 
+/**
+ * Writes the modules of all kernel descriptions
+ * @returns {Array} the generated c files
+ */
+function generate() {
+  let files = fs.readdirSync(kernelDir).filter(file => path.extname(file) === ".js").sort();
+  let kernels = files.map(file => {
+    let kernel = require(kernelDir + file);
+    fs.writeFileSync(cDir + kernel.name + ".c", emitSource(kernel, file), "utf-8");
+    fs.writeFileSync(cDir + "bridges/" + kernel.name + ".js", emitBridge(kernel), "utf-8");
+    return kernel;
+  });
+  let sources = kernels.map(kernel => kernel.name + ".c");
+  fs.writeFileSync(sourceDir + "generated.js", emitIndex(kernels), "utf-8");
+  fs.writeFileSync(cDir + "generated.json", JSON.stringify(sources, null, 2) + "\n", "utf-8");
+  return sources;
 };
+
+module.exports = generate;
+
+if (require.main === module) generate();
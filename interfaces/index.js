@@ -1,6 +1,6 @@
 const fs = require("fs");
 const glMatrix = require("../static/gl-matrix.min.js");
-const generate = require("./generate");
+const parse = require("./parse");
 
 let sourceDir = __dirname + "/../gl-matrix/";
 let moduleSources = require(__dirname + "/modules");
@@ -11,7 +11,7 @@ let interfaces = {};
 let specialInterfaces = {};
 moduleSources.map(moduleName => {
   let file = fs.readFileSync(sourceDir + moduleName + ".js", "utf-8");
-  let table = generate(file);
+  let table = parse(file);
   // full interface
   {
     interfaces[moduleName] = {};
@@ -0,0 +1,337 @@
+/**
+ * Description of the vec2 module, see generate.js
+ */
+module.exports = {
+  name: "vec2",
+  size: 2,
+  methods: [
+    {
+      name: "create",
+      kind: "create",
+      doc: "Creates a new, empty vec2",
+      values: ["0", "0"]
+    },
+    {
+      name: "clone",
+      kind: "clone",
+      doc: "Creates a new vec2 initialized with values from an existing vector"
+    },
+    {
+      name: "fromValues",
+      kind: "fromValues",
+      doc: "Creates a new vec2 initialized with the given values",
+      params: ["Number x X component", "Number y Y component"]
+    },
+    {
+      name: "copy",
+      kind: "componentwise",
+      doc: "Copy the values from one vec2 to another",
+      params: ["vec2 a the source vector"],
+      expr: "a[i]",
+      simd: "$a"
+    },
+    {
+      name: "set",
+      kind: "custom",
+      doc: "Set the components of a vec2 to the given values",
+      params: ["vec2 out the receiving vector", "Number x X component", "Number y Y component"],
+      returns: "vec2 out",
+      body: [
+        "out[0] = x;",
+        "out[1] = y;",
+        "return out;"
+      ]
+    },
+    {
+      name: "add",
+      kind: "componentwise",
+      doc: "Adds two vec2's",
+      params: ["vec2 a the first operand", "vec2 b the second operand"],
+      expr: "a[i] + b[i]",
+      simd: "wasm_f32x4_add($a, $b)"
+    },
+    {
+      name: "subtract",
+      kind: "componentwise",
+      doc: "Subtracts vector b from vector a",
+      params: ["vec2 a the first operand", "vec2 b the second operand"],
+      expr: "a[i] - b[i]",
+      simd: "wasm_f32x4_sub($a, $b)"
+    },
+    {
+      name: "multiply",
+      kind: "componentwise",
+      doc: "Multiplies two vec2's",
+      params: ["vec2 a the first operand", "vec2 b the second operand"],
+      expr: "a[i] * b[i]",
+      simd: "wasm_f32x4_mul($a, $b)"
+    },
+    {
+      name: "divide",
+      kind: "componentwise",
+      doc: "Divides two vec2's",
+      params: ["vec2 a the first operand", "vec2 b the second operand"],
+      expr: "a[i] / b[i]",
+      simd: "wasm_f32x4_div($a, $b)"
+    },
+    {
+      name: "ceil",
+      kind: "componentwise",
+      doc: "Math.ceil the components of a vec2",
+      params: ["vec2 a vector to ceil"],
+      expr: "ceilf(a[i])",
+      simd: "wasm_f32x4_ceil($a)"
+    },
+    {
+      name: "floor",
+      kind: "componentwise",
+      doc: "Math.floor the components of a vec2",
+      params: ["vec2 a vector to floor"],
+      expr: "floorf(a[i])",
+      simd: "wasm_f32x4_floor($a)"
+    },
+    {
+      name: "min",
+      kind: "componentwise",
+      doc: "Returns the minimum of two vec2's",
+      params: ["vec2 a the first operand", "vec2 b the second operand"],
+      expr: "b[i] < a[i] ? b[i] : a[i]",
+      simd: "wasm_f32x4_pmin($a, $b)"
+    },
+    {
+      name: "max",
+      kind: "componentwise",
+      doc: "Returns the maximum of two vec2's",
+      params: ["vec2 a the first operand", "vec2 b the second operand"],
+      expr: "a[i] < b[i] ? b[i] : a[i]",
+      simd: "wasm_f32x4_pmax($a, $b)"
+    },
+    {
+      name: "round",
+      kind: "componentwise",
+      doc: "Math.round the components of a vec2",
+      params: ["vec2 a vector to round"],
+      expr: "roundf(a[i])"
+    },
+    {
+      name: "scale",
+      kind: "componentwise",
+      doc: "Scales a vec2 by a scalar number",
+      params: ["vec2 a the vector to scale", "Number b amount to scale the vector by"],
+      expr: "a[i] * b",
+      simd: "wasm_f32x4_mul($a, $b)"
+    },
+    {
+      name: "scaleAndAdd",
+      kind: "componentwise",
+      doc: "Adds two vec2's after scaling the second operand by a scalar value",
+      params: ["vec2 a the first operand", "vec2 b the second operand", "Number scale the amount to scale b by before adding"],
+      expr: "a[i] + (b[i] * scale)",
+      simd: "wasm_f32x4_add($a, wasm_f32x4_mul($b, $scale))"
+    },
+    {
+      name: "distance",
+      kind: "reduce",
+      doc: "Calculates the euclidian distance between two vec2's",
+      params: ["vec2 a the first operand", "vec2 b the second operand"],
+      returns: "Number distance between a and b",
+      temp: "b[i] - a[i]",
+      expr: "t * t",
+      wrap: "sqrtf(%)"
+    },
+    {
+      name: "squaredDistance",
+      kind: "reduce",
+      doc: "Calculates the squared euclidian distance between two vec2's",
+      params: ["vec2 a the first operand", "vec2 b the second operand"],
+      returns: "Number squared distance between a and b",
+      temp: "b[i] - a[i]",
+      expr: "t * t"
+    },
+    {
+      name: "length",
+      kind: "reduce",
+      doc: "Calculates the length of a vec2",
+      params: ["vec2 a vector to calculate length of"],
+      returns: "Number length of a",
+      expr: "a[i] * a[i]",
+      wrap: "sqrtf(%)"
+    },
+    {
+      name: "squaredLength",
+      kind: "reduce",
+      doc: "Calculates the squared length of a vec2",
+      params: ["vec2 a vector to calculate squared length of"],
+      returns: "Number squared length of a",
+      expr: "a[i] * a[i]"
+    },
+    {
+      name: "negate",
+      kind: "componentwise",
+      doc: "Negates the components of a vec2",
+      params: ["vec2 a vector to negate"],
+      expr: "-a[i]",
+      simd: "wasm_f32x4_neg($a)"
+    },
+    {
+      name: "inverse",
+      kind: "componentwise",
+      doc: "Returns the inverse of the components of a vec2",
+      params: ["vec2 a vector to invert"],
+      expr: "1.0 / a[i]",
+      simd: "wasm_f32x4_div(wasm_f32x4_splat(1.0), $a)"
+    },
+    {
+      name: "normalize",
+      kind: "custom",
+      doc: "Normalize a vec2",
+      params: ["vec2 out the receiving vector", "vec2 a vector to normalize"],
+      returns: "vec2 out",
+      body: [
+        "float x = a[0];",
+        "float y = a[1];",
+        "float len = x*x + y*y;",
+        "if (len > 0) {",
+        "  len = INVSQRT(len);",
+        "  out[0] = a[0] * len;",
+        "  out[1] = a[1] * len;",
+        "}",
+        "return out;"
+      ]
+    },
+    {
+      name: "dot",
+      kind: "reduce",
+      doc: "Calculates the dot product of two vec2's",
+      params: ["vec2 a the first operand", "vec2 b the second operand"],
+      returns: "Number dot product of a and b",
+      expr: "a[i] * b[i]"
+    },
+    {
+      name: "cross",
+      kind: "custom",
+      doc: "Computes the cross product of two vec2's\n * Note that the cross product must by definition produce a 3D vector",
+      params: ["vec3 out the receiving vector", "vec2 a the first operand", "vec2 b the second operand"],
+      returns: "vec3 out",
+      body: [
+        "float z = a[0] * b[1] - a[1] * b[0];",
+        "out[0] = out[1] = 0;",
+        "out[2] = z;",
+        "return out;"
+      ]
+    },
+    {
+      name: "lerp",
+      kind: "componentwise",
+      doc: "Performs a linear interpolation between two vec2's",
+      params: ["vec2 a the first operand", "vec2 b the second operand", "Number t interpolation amount between the two inputs"],
+      expr: "a[i] + t * (b[i] - a[i])",
+      simd: "wasm_f32x4_add($a, wasm_f32x4_mul($t, wasm_f32x4_sub($b, $a)))"
+    },
+    {
+      name: "random",
+      kind: "custom",
+      doc: "Generates a random vector with the given scale",
+      params: ["vec2 out the receiving vector", "Number [scale] Length of the resulting vector. If ommitted, a unit vector will be returned"],
+      returns: "vec2 out",
+      body: [
+        "float r = randf() * 2.0 * PI;",
+        "out[0] = COS(r) * scale;",
+        "out[1] = SIN(r) * scale;",
+        "return out;"
+      ]
+    },
+    {
+      name: "transformMat2",
+      kind: "custom",
+      doc: "Transforms the vec2 with a mat2",
+      params: ["vec2 out the receiving vector", "vec2 a the vector to transform", "mat2 m matrix to transform with"],
+      returns: "vec2 out",
+      body: [
+        "float x = a[0], y = a[1];",
+        "out[0] = m[0] * x + m[2] * y;",
+        "out[1] = m[1] * x + m[3] * y;",
+        "return out;"
+      ]
+    },
+    {
+      name: "transformMat2d",
+      kind: "custom",
+      doc: "Transforms the vec2 with a mat2d",
+      params: ["vec2 out the receiving vector", "vec2 a the vector to transform", "mat2d m matrix to transform with"],
+      returns: "vec2 out",
+      body: [
+        "float x = a[0], y = a[1];",
+        "out[0] = m[0] * x + m[2] * y + m[4];",
+        "out[1] = m[1] * x + m[3] * y + m[5];",
+        "return out;"
+      ]
+    },
+    {
+      name: "transformMat3",
+      kind: "custom",
+      doc: "Transforms the vec2 with a mat3\n * 3rd vector component is implicitly '1'",
+      params: ["vec2 out the receiving vector", "vec2 a the vector to transform", "mat3 m matrix to transform with"],
+      returns: "vec2 out",
+      body: [
+        "float x = a[0], y = a[1];",
+        "out[0] = m[0] * x + m[3] * y + m[6];",
+        "out[1] = m[1] * x + m[4] * y + m[7];",
+        "return out;"
+      ]
+    },
+    {
+      name: "transformMat4",
+      kind: "custom",
+      doc: "Transforms the vec2 with a mat4\n * 3rd vector component is implicitly '0'\n * 4th vector component is implicitly '1'",
+      params: ["vec2 out the receiving vector", "vec2 a the vector to transform", "mat4 m matrix to transform with"],
+      returns: "vec2 out",
+      body: [
+        "float x = a[0], y = a[1];",
+        "out[0] = m[0] * x + m[4] * y + m[12];",
+        "out[1] = m[1] * x + m[5] * y + m[13];",
+        "return out;"
+      ]
+    },
+    {
+      name: "str",
+      kind: "custom",
+      doc: "Returns a string representation of a vector",
+      params: ["vec2 a vector to represent as a string"],
+      returns: "String string representation of the vector",
+      body: [
+        "return a;"
+      ]
+    },
+    {
+      name: "exactEquals",
+      kind: "custom",
+      doc: "Returns whether or not the vectors exactly have the same elements in the same position (when compared with ===)",
+      params: ["vec2 a The first vector.", "vec2 b The second vector."],
+      returns: "Boolean True if the vectors are equal, false otherwise.",
+      body: [
+        "return a[0] == b[0] && a[1] == b[1];"
+      ]
+    },
+    {
+      name: "equals",
+      kind: "custom",
+      doc: "Returns whether or not the vectors have approximately the same elements in the same position.",
+      params: ["vec2 a The first vector.", "vec2 b The second vector."],
+      returns: "Boolean True if the vectors are equal, false otherwise.",
+      body: [
+        "float a0 = a[0], a1 = a[1];",
+        "float b0 = b[0], b1 = b[1];",
+        "return (fabs(a0 - b0) <= EPSILON*fmaxf(1.0, fmaxf(fabs(a0), fabs(b0))) &&",
+        "        fabs(a1 - b1) <= EPSILON*fmaxf(1.0, fmaxf(fabs(a1), fabs(b1))));"
+      ]
+    },
+    { name: "len", kind: "alias", target: "length" },
+    { name: "sub", kind: "alias", target: "subtract" },
+    { name: "mul", kind: "alias", target: "multiply" },
+    { name: "div", kind: "alias", target: "divide" },
+    { name: "dist", kind: "alias", target: "distance" },
+    { name: "sqrDist", kind: "alias", target: "squaredDistance" },
+    { name: "sqrLen", kind: "alias", target: "squaredLength" }
+  ]
+};
@@ -0,0 +1,13 @@
+{
+  "targets": [
+    {
+      "target_name": "glmw",
+      "sources": ["glmw.c"],
+      "include_dirs": ["shim", "src"],
+      "cflags": ["-std=gnu11", "-O3", "-march=native", "-ffp-contract=off", "-Wno-implicit-int"],
+      "xcode_settings": {
+        "OTHER_CFLAGS": ["-std=gnu11", "-O3", "-march=native", "-ffp-contract=off", "-Wno-implicit-int"]
+      }
+    }
+  ]
+}
@@ -0,0 +1,174 @@
+/**
+ * N-API backend, built by rollup/compile.native.js. The modules are
+ * compiled for the host CPU and allocate from a single heap exposed
+ * to JavaScript as an ArrayBuffer. Addresses are offsets into that
+ * heap, so they behave like the addresses of the WebAssembly build
+ * and the same memory views and bridges work on top of it
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <node_api.h>
+
+#include "config.h"
+
+/**
+ * Power of two size classes with a free list each. The allocator
+ * state lives at the start of the heap, so it is part of snapshots
+ * and no allocation can be at address 0
+ */
+#define HEAP_ALIGN 16
+#define HEAP_CLASSES 32
+
+typedef struct {
+  uint32_t size;
+  uint32_t top;
+  uint32_t freeLists[HEAP_CLASSES];
+} HeapState;
+
+unsigned char *heap = NULL;
+napi_ref heapRef = NULL;
+
+int heapClass(size_t size) {
+  int c = 5;
+  while (c < HEAP_CLASSES && ((size_t) 1 << c) < size + HEAP_ALIGN) c++;
+  return c;
+};
+
+void *heapAlloc(size_t size) {
+  HeapState *state = (HeapState *) heap;
+  int c = heapClass(size);
+  if (c >= HEAP_CLASSES) return NULL;
+  uint32_t block = state->freeLists[c];
+  if (block) {
+    state->freeLists[c] = *(uint32_t *) (heap + block + HEAP_ALIGN);
+  } else {
+    uint32_t bytes = 1u << c;
+    if (bytes > state->size - state->top) return NULL;
+    block = state->top;
+    state->top += bytes;
+  }
+  *(uint32_t *) (heap + block) = c;
+  return heap + block + HEAP_ALIGN;
+};
+
+void heapFree(void *ptr) {
+  HeapState *state = (HeapState *) heap;
+  if (!ptr) return;
+  uint32_t block = (unsigned char *) ptr - heap - HEAP_ALIGN;
+  int c = *(uint32_t *) (heap + block);
+  *(uint32_t *) (heap + block + HEAP_ALIGN) = state->freeLists[c];
+  state->freeLists[c] = block;
+};
+
+#include "modules.h"
+
+typedef struct {
+  char const *name;
+  napi_callback fn;
+} NativeExport;
+
+void nativeArgs(napi_env env, napi_callback_info info, napi_value *argv, size_t count) {
+  size_t argc = count;
+  napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+  // missing arguments are undefined and read as 0
+  for (size_t ii = argc; ii < count; ++ii) napi_get_undefined(env, &argv[ii]);
+};
+
+void *nativePointer(napi_env env, napi_value value) {
+  uint32_t offset = 0;
+  napi_get_value_uint32(env, value, &offset);
+  return offset ? heap + offset : NULL;
+};
+
+double nativeNumber(napi_env env, napi_value value) {
+  double out = 0;
+  napi_get_value_double(env, value, &out);
+  return out;
+};
+
+int32_t nativeInt(napi_env env, napi_value value) {
+  int32_t out = 0;
+  napi_get_value_int32(env, value, &out);
+  return out;
+};
+
+napi_value nativeOffset(napi_env env, void *ptr) {
+  napi_value out;
+  napi_create_uint32(env, ptr ? (uint32_t) ((unsigned char *) ptr - heap) : 0, &out);
+  return out;
+};
+
+napi_value nativeNumberValue(napi_env env, double value) {
+  napi_value out;
+  napi_create_double(env, value, &out);
+  return out;
+};
+
+napi_value nativeIntValue(napi_env env, int32_t value) {
+  napi_value out;
+  napi_create_int32(env, value, &out);
+  return out;
+};
+
+#include "exports.h"
+
+/**
+ * Creates the heap, can only be called once
+ *
+ * @param {Number} size size of the heap in bytes, at most 2 GiB
+ * @returns {ArrayBuffer} the heap
+ */
+napi_value nativeInit(napi_env env, napi_callback_info info) {
+  napi_value argv[1];
+  napi_value out;
+  void *data = NULL;
+  nativeArgs(env, info, argv, 1);
+  if (heap) {
+    napi_throw_error(env, NULL, "The native heap was already created");
+    return NULL;
+  }
+  double size = nativeNumber(env, argv[0]);
+  if (size < sizeof(HeapState) + HEAP_ALIGN || size > 2147483648.0) {
+    napi_throw_range_error(env, NULL, "Invalid native heap size");
+    return NULL;
+  }
+  size_t bytes = (size_t) size & ~(size_t) (HEAP_ALIGN - 1);
+  if (napi_create_arraybuffer(env, bytes, &data, &out) != napi_ok) return NULL;
+  napi_create_reference(env, out, 1, &heapRef);
+  // zero-filled by the engine
+  heap = data;
+  HeapState *state = (HeapState *) heap;
+  state->size = bytes;
+  state->top = (sizeof(HeapState) + HEAP_ALIGN - 1) & ~(HEAP_ALIGN - 1);
+  return out;
+};
+
+/**
+ * High-water mark of the allocator, snapshots copy the heap up to it
+ *
+ * @returns {Number} the top of the heap in bytes
+ */
+napi_value nativeSnapshotTop(napi_env env, napi_callback_info info) {
+  napi_value out;
+  (void) info;
+  napi_create_uint32(env, heap ? ((HeapState *) heap)->top : 0, &out);
+  return out;
+};
+
+napi_value nativeRegister(napi_env env, napi_value exports) {
+  napi_value value;
+  for (int ii = 0; ii < EXPORT_COUNT; ++ii) {
+    napi_create_function(env, nativeExports[ii].name, NAPI_AUTO_LENGTH, nativeExports[ii].fn, NULL, &value);
+    napi_set_named_property(env, exports, nativeExports[ii].name, value);
+  };
+  napi_create_function(env, "init", NAPI_AUTO_LENGTH, nativeInit, NULL, &value);
+  napi_set_named_property(env, exports, "init", value);
+  napi_create_function(env, "snapshot_top", NAPI_AUTO_LENGTH, nativeSnapshotTop, NULL, &value);
+  napi_set_named_property(env, exports, "snapshot_top", value);
+  napi_create_uint32(env, GLMW_FINGERPRINT, &value);
+  napi_set_named_property(env, exports, "fingerprint", value);
+  return exports;
+};
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, nativeRegister)
@@ -0,0 +1,22 @@
+/**
+ * Stands in for the webassembly package's header when compiling
+ * the modules natively. Allocations are served from the heap of
+ * the addon, so every address is an offset into one ArrayBuffer
+ */
+#ifndef GLMW_NATIVE_SHIM_H_
+#define GLMW_NATIVE_SHIM_H_
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define export
+#define import extern
+
+void *heapAlloc(size_t size);
+void heapFree(void *ptr);
+
+#define malloc heapAlloc
+#define free heapFree
+
+#endif
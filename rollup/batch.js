@@ -0,0 +1,141 @@
+/**
+ * Generates strided array variants of the elementwise exports.
+ * Every export of the form fn(out, a, ...) returning out, where out
+ * and a are vectors of its module, gets an
+ * fnArray(out, a, ..., count, stride, offset) which applies it to count
+ * elements of (interleaved) buffers. The other vector operands (b, c, d)
+ * are buffers as well, read with the same stride and offset as a,
+ * scalars, matrices and the vectors listed in SHARED (like the origin
+ * of the rotations) are shared by all elements. This is the only
+ * generator of array variants, interfaces/generate.js uses it as well
+ */
+const parse = require("./parse");
+
+const SIZES = {
+  vec3: "VEC_SIZE_3",
+  vec4: "VEC_SIZE_4"
+};
+
+// vector params passed unchanged to every element, by method name
+const SHARED = {
+  rotateX: ["b"],
+  rotateY: ["b"],
+  rotateZ: ["b"]
+};
+
+const PARAM_RX = /@param\s+\{(\w+)\}\s+\[?(\w+)/;
+
+/**
+ * @returns {Object} the documented type of every param by name
+ */
+function getParamTypes(decl) {
+  let types = {};
+  decl.comment.split("\n").map(line => {
+    let match = line.match(PARAM_RX);
+    if (match) types[match[2]] = match[1];
+  });
+  return types;
+};
+
+function isShared(decl, name) {
+  return (SHARED[decl.name] || []).indexOf(name) !== -1;
+};
+
+/**
+ * Whether a param is a vector of the module, these are strided
+ */
+function isStrided(decl, param) {
+  return (
+    param.pointer &&
+    getParamTypes(decl)[param.name] === decl.namespace &&
+    !isShared(decl, param.name)
+  );
+};
+
+function isElementwise(decl) {
+  let params = decl.params;
+  return (
+    decl.ret.trim() === "float *" &&
+    params.length >= 2 &&
+    params[0].name === "out" && isStrided(decl, params[0]) &&
+    params[1].name === "a" && isStrided(decl, params[1]) &&
+    !/@returns? \{\w+\} a new/i.test(decl.comment) &&
+    !/Alias for/.test(decl.comment)
+  );
+};
+
+function emitComment(decl) {
+  let summary = `Strided array variant of {@link ${decl.namespace}.${decl.name}}`;
+  let params = decl.comment.split("\n").filter(line => {
+    let match = line.match(PARAM_RX);
+    return match && match[2] !== "out" && match[2] !== "a";
+  }).map(line => {
+    let name = line.match(PARAM_RX)[2];
+    if (isShared(decl, name)) return line + ", shared by all elements";
+    return line.replace(`{${decl.namespace}}`, "{Float32Array}");
+  });
+  return [
+    `/**`,
+    ` * ${summary}`,
+    ` *`,
+    ` * @param {Float32Array} out the receiving buffer`,
+    ` * @param {Float32Array} a the source buffer`,
+    ...params,
+    ` * @param {Number} count amount of elements`,
+    ` * @param {Number} stride floats between the elements of all buffers, 0 for tightly packed`,
+    ` * @param {Number} offset floats before the first element of all buffers`,
+    ` * @returns {Float32Array} out`,
+    ` */`
+  ].join("\n");
+};
+
+/**
+ * @param {Object} decl the scalar export
+ * @param {String} size the size macro of the elements
+ * @param {Array} [packed] lines inserted before the strided loop,
+ *  e.g. a faster path for tightly packed buffers
+ * @returns {String} the array variant
+ */
+function emitArray(decl, size, packed = []) {
+  let ns = decl.namespace;
+  let rest = decl.params.slice(2);
+  let signature = ["float *out", "float *a"]
+    .concat(rest.map(param => param.source))
+    .concat(["int count", "int stride", "int offset"])
+    .join(", ");
+  let args = ["out + jj", "a + jj"]
+    .concat(rest.map(param => isStrided(decl, param) ? `${param.name} + jj` : param.name))
+    .join(", ");
+  return [
+    emitComment(decl),
+    `export float *${ns}(${decl.name}Array)(${signature}) {`,
+    `  if (!stride) stride = ${size};`,
+    ...packed,
+    `  for (int ii = 0, jj = offset; ii < count; ++ii, jj += stride) {`,
+    `    ${ns}(${decl.name})(${args});`,
+    `  };`,
+    `  return out;`,
+    `};`
+  ].join("\n");
+};
+
+/**
+ * @param {String} source module source
+ * @param {Object} [options]
+ * @param {Object} [options.sizes] size macro per namespace, vec3 and vec4 by default
+ * @param {Function} [options.packed] returns the packed path lines of a decl
+ * @returns {String} the source with the array variants appended
+ */
+module.exports = function(source, options = {}) {
+  let sizes = options.sizes || SIZES;
+  let variants = [];
+  parse.walk(source, (line, decl) => {
+    if (!decl || !sizes[decl.namespace] || !isElementwise(decl)) return;
+    let packed = options.packed ? options.packed(decl) : [];
+    variants.push(emitArray(decl, sizes[decl.namespace], packed));
+  });
+  if (!variants.length) return source;
+  return source + "\n// generated by rollup/batch.js\n\n" + variants.join("\n\n") + "\n";
+};
+
+module.exports.isStrided = isStrided;
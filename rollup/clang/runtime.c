@@ -0,0 +1,27 @@
+/**
+ * The bridges keep typed views on memory, which detach whenever
+ * the memory grows. wasi-libc's malloc grows it through sbrk, which
+ * is wrapped (--wrap=sbrk) to let JavaScript renew the views after
+ * growing, like the runtime of the webassembly package does
+ */
+#include <stdint.h>
+
+__attribute__((import_module("env"), import_name("_grow")))
+void runtimeGrow(void);
+
+void *__real_sbrk(intptr_t increment);
+
+void *__wrap_sbrk(intptr_t increment) {
+  unsigned long pages = __builtin_wasm_memory_size(0);
+  void *out = __real_sbrk(increment);
+  if (__builtin_wasm_memory_size(0) != pages) runtimeGrow();
+  return out;
+};
+
+/**
+ * High-water mark of malloc, the data and the stack lie below it.
+ * Snapshots copy the memory up to it
+ */
+uint32_t snapshot_top(void) {
+  return (uintptr_t) __real_sbrk(0);
+};
@@ -0,0 +1,16 @@
+/**
+ * Stands in for the webassembly package's header when building
+ * with clang and wasm-ld against a wasi-libc sysroot. The exports
+ * are passed to the linker by name (see compile.clang.js)
+ */
+#ifndef GLMW_CLANG_SHIM_H_
+#define GLMW_CLANG_SHIM_H_
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define export
+#define import extern
+
+#endif
@@ -0,0 +1,89 @@
+/**
+ * Builds the modules with clang and wasm-ld instead of the webassembly
+ * package, which can't emit post-MVP features. Needs a clang with the
+ * wasm32 target and a wasi-libc sysroot for malloc and libm, found at
+ * $WASI_SYSROOT (defaults to the one of wasi-sdk). The build flavours
+ * are the same, the feature set is chosen by target name or as a
+ * comma separated list of features. Experimental: not yet verified
+ * against a real wasi-sdk, see the README
+ */
+const fs = require("fs");
+const child = require("child_process");
+const parse = require("./parse");
+const wasm = require("./compile.wasm");
+
+let output = `./wasm_tmp.wasm`;
+
+const FEATURES = {
+  "simd128": "-msimd128",
+  "bulk-memory": "-mbulk-memory",
+  "nontrapping-fptoint": "-mnontrapping-fptoint"
+};
+
+let targets = {
+  mvp: [],
+  modern: ["bulk-memory", "nontrapping-fptoint"],
+  simd: ["simd128", "bulk-memory", "nontrapping-fptoint"]
+};
+
+function getFeatures(target) {
+  let features = targets[target] || target.split(",").filter(feature => feature.length);
+  features.map(feature => {
+    if (!FEATURES[feature]) throw new Error(`Unknown feature ${feature}`);
+  });
+  return features;
+};
+
+function getExports(input) {
+  let exports = [];
+  input.files.map(file => {
+    parse.walk(fs.readFileSync(input.dir + file, "utf-8"), (line, decl) => decl && exports.push(decl.id));
+  });
+  return exports;
+};
+
+module.exports = function(name = "release", target = "simd") {
+  let flavour = wasm.flavours[name];
+  if (!flavour) throw new Error(`Unknown build flavour ${name}`);
+  let features = getFeatures(target);
+  let sysroot = process.env.WASI_SYSROOT || "/opt/wasi-sdk/share/wasi-sysroot";
+  let input = wasm.prepare(flavour);
+  fs.copyFileSync(__dirname + "/clang/runtime.c", input.dir + "runtime.c");
+  let args = [
+    "--target=wasm32-wasi",
+    `--sysroot=${sysroot}`,
+    "-std=gnu11",
+    "-O3",
+    "-flto",
+    "-nostartfiles",
+    "-Wno-implicit-int",
+    "-Wno-error=implicit-int",
+    "-Wno-gnu-folding-constant",
+    "-I", __dirname + "/clang",
+    "-I", input.dir
+  ];
+  features.map(feature => args.push(FEATURES[feature]));
+  flavour.defines.map(define => args.push("-D", define));
+  // keep the debug info and names of the debug flavour
+  if (name === "debug") args.push("-g");
+  input.files.concat("runtime.c").map(file => args.push("-include", input.dir + file));
+  args.push(
+    "-Wl,--no-entry",
+    "-Wl,--lto-O3",
+    `-Wl,--allow-undefined-file=${__dirname}/clang/imports.txt`,
+    "-Wl,--wrap=sbrk"
+  );
+  if (name !== "debug") args.push("-Wl,--strip-debug");
+  getExports(input).concat("snapshot_top").map(id => args.push(`-Wl,--export=${id}`));
+  args.push(input.dir + "main.c", "-o", output);
+  try {
+    child.execFileSync(process.env.CC || "clang", args, { stdio: "inherit" });
+    wasm.emitModule(fs.readFileSync(output));
+  } finally {
+    wasm.cleanup();
+    if (fs.existsSync(output)) fs.unlinkSync(output);
+  }
+  return Promise.resolve();
+};
+
+if (require.main === module) module.exports(process.argv[2], process.argv[3]);
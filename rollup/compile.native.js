@@ -0,0 +1,102 @@
+/**
+ * Builds the optional N-API backend (native/) from the same module
+ * sources as the WebAssembly build. The modules are copied along with
+ * their generated array variants into native/src, together with an
+ * N-API wrapper for every export, and compiled by node-gyp for the
+ * host CPU. Usage: node rollup/compile.native.js [release|fast]
+ */
+const fs = require("fs");
+const child = require("child_process");
+const parse = require("./parse");
+const batch = require("./batch");
+const modules = require("./modules");
+
+let source = `src/gl-matrix/`;
+let target = `native/src/`;
+
+let flavours = {
+  release: [],
+  fast: ["GLMW_FAST_MATH"]
+};
+
+function isFloat(type) {
+  return /^(float|double)$/.test(type.trim());
+};
+
+function emitArg(param, index) {
+  let type = param.source.slice(0, -param.name.length).trim();
+  if (param.pointer) return `(${type}) nativePointer(env, argv[${index}])`;
+  if (isFloat(type)) return `(${type}) nativeNumber(env, argv[${index}])`;
+  return `(${type}) nativeInt(env, argv[${index}])`;
+};
+
+function emitReturn(ret, call) {
+  if (ret.indexOf("*") > -1) return `return nativeOffset(env, ${call});`;
+  if (isFloat(ret)) return `return nativeNumberValue(env, ${call});`;
+  if (ret.trim() === "void") return `${call};\n  return NULL;`;
+  return `return nativeIntValue(env, ${call});`;
+};
+
+function emitWrapper(decl) {
+  let count = decl.params.length;
+  let args = decl.params.map(emitArg).join(", ");
+  return [
+    `napi_value native_${decl.id}(napi_env env, napi_callback_info info) {`,
+    count ? `  napi_value argv[${count}];\n  nativeArgs(env, info, argv, ${count});` : `  (void) info;`,
+    `  ${emitReturn(decl.ret, `${decl.id}(${args})`)}`,
+    `};`
+  ].filter(line => line.length).join("\n");
+};
+
+function emitExports(exports) {
+  let entries = exports.map(decl => `  { "${decl.id}", native_${decl.id} }`);
+  return [
+    exports.map(emitWrapper).join("\n\n"),
+    ``,
+    `#define EXPORT_COUNT ${exports.length}`,
+    `NativeExport nativeExports[EXPORT_COUNT] = {`,
+    entries.join(",\n"),
+    `};`,
+    ``
+  ].join("\n");
+};
+
+// FNV-1a over the sources, identifies the build in snapshots
+function fingerprint(text) {
+  let hash = 0x811C9DC5;
+  for (let ii = 0; ii < text.length; ++ii) {
+    hash ^= text.charCodeAt(ii) & 0xFF;
+    hash = Math.imul(hash, 0x01000193);
+  };
+  return hash >>> 0;
+};
+
+function prepare(defines) {
+  if (!fs.existsSync(target)) fs.mkdirSync(target);
+  fs.readdirSync(source).map(file => {
+    let path = source + file;
+    if (fs.statSync(path).isFile()) fs.writeFileSync(target + file, fs.readFileSync(path));
+  });
+  let exports = [];
+  let text = defines.join("\n");
+  modules.map(file => {
+    let code = batch(fs.readFileSync(source + file, "utf-8"));
+    parse.walk(code, (line, decl) => decl && exports.push(decl));
+    fs.writeFileSync(target + file, code, "utf-8");
+    text += code;
+  });
+  let config = defines.map(define => `#define ${define}`);
+  config.push(`#define GLMW_FINGERPRINT ${fingerprint(text)}u`);
+  fs.writeFileSync(target + "config.h", config.join("\n") + "\n", "utf-8");
+  fs.writeFileSync(target + "modules.h", modules.map(file => `#include "${file}"`).join("\n") + "\n", "utf-8");
+  fs.writeFileSync(target + "exports.h", emitExports(exports), "utf-8");
+};
+
+module.exports = function(name = "release") {
+  let defines = flavours[name];
+  if (!defines) throw new Error(`Unknown native build flavour ${name}`);
+  prepare(defines);
+  child.execSync("node-gyp rebuild", { cwd: "native", stdio: "inherit" });
+};
+
+if (require.main === module) module.exports(process.argv[2]);
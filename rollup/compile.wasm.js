@@ -1,30 +1,115 @@
 const fs = require("fs");
 const compiler = require("webassembly/cli/compiler");
+const instrument = require("./instrument");
+const hooks = require("./hooks");
+const batch = require("./batch");
 
 let source = `src/gl-matrix/`;
+let temp = `./wasm_tmp/`;
 
-let args = [
-  "-q",
-  "-O3",
-  source + "main.c",
-  "-o", "./wasm_tmp.wasm",
-  "-i", source + "mat4.c",
-  "-i", source + "vec3.c",
-  "-i", source + "vec4.c"
-];
-
-module.exports = function() {
+let modules = require("./modules");
+
+/**
+ * Build flavours, selectable by name. The modules are
+ * compiled from copies with their generated array variants
+ * appended, instrumented flavours additionally rewrite them
+ * and link in their runtime before them
+ */
+let flavours = {
+  release: {
+    defines: [],
+    runtime: [],
+    hooks: []
+  },
+  fast: {
+    defines: ["GLMW_FAST_MATH"],
+    runtime: [],
+    hooks: []
+  },
+  profile: {
+    defines: ["GLMW_PROFILE"],
+    runtime: ["profile.c"],
+    hooks: [hooks.profile]
+  },
+  debug: {
+    defines: ["GLMW_DEBUG"],
+    runtime: ["debug.c"],
+    hooks: [hooks.debug]
+  }
+};
+
+function emitExportTable(exports) {
+  let names = exports.map(decl => `  "${decl.id}"`);
+  return [
+    `#define EXPORT_COUNT ${exports.length}`,
+    `char const *exportNames[EXPORT_COUNT] = {`,
+    names.join(",\n"),
+    `};`,
+    ``
+  ].join("\n");
+};
+
+function prepare(flavour) {
+  if (!fs.existsSync(temp)) fs.mkdirSync(temp);
+  fs.readdirSync(source).map(file => {
+    let path = source + file;
+    if (fs.statSync(path).isFile()) fs.writeFileSync(temp + file, fs.readFileSync(path));
+  });
+  let files = {};
+  modules.map(file => files[file] = batch(fs.readFileSync(source + file, "utf-8")));
+  if (flavour.hooks.length) {
+    let result = instrument(files, flavour.hooks);
+    files = result.files;
+    files["exports.h"] = emitExportTable(result.exports);
+  }
+  for (let file in files) {
+    fs.writeFileSync(temp + file, files[file], "utf-8");
+  };
+  let includes = flavour.hooks.length ? ["exports.h"] : [];
+  return { dir: temp, files: includes.concat(flavour.runtime, modules) };
+};
+
+function cleanup() {
+  fs.readdirSync(temp).map(file => fs.unlinkSync(temp + file));
+  fs.rmdirSync(temp);
+};
+
+/**
+ * Embeds a compiled binary as src/module.js
+ */
+function emitModule(data) {
+  let code = `
+    let binary = new Uint8Array([${new Uint8Array(data).toString()}]);
+    export default binary;
+  `;
+  fs.writeFileSync("src/module.js", code, "utf-8");
+};
+
+module.exports = function(name = "release") {
+  let flavour = flavours[name];
+  if (!flavour) throw new Error(`Unknown build flavour ${name}`);
+  let input = prepare(flavour);
+  let args = [
+    "-q",
+    "-O3",
+    input.dir + "main.c",
+    "-o", "./wasm_tmp.wasm"
+  ];
+  flavour.defines.map(define => args.push("-D", define));
+  input.files.map(file => args.push("-i", input.dir + file));
   return new Promise((resolve) => {
     compiler.main(args, (e, path) => {
+      cleanup();
       if (e) throw e;
-      let data = fs.readFileSync(path);
-      let code = `
-        let binary = new Uint8Array([${new Uint8Array(data).toString()}]);
-        export default binary;
-      `;
+      emitModule(fs.readFileSync(path));
       fs.unlinkSync(path);
-      fs.writeFileSync("src/module.js", code, "utf-8");
       resolve();
     });
   });
 };
+
+// shared with the clang toolchain (compile.clang.js)
+module.exports.flavours = flavours;
+module.exports.prepare = prepare;
+module.exports.cleanup = cleanup;
+module.exports.emitModule = emitModule;
@@ -0,0 +1,68 @@
+/**
+ * Hooks injected around every export by the
+ * instrumented build flavours, see instrument.js
+ */
+
+// doc comment types to allocation tags of debug.c
+const DEBUG_TAGS = {
+  mat4: "DEBUG_MAT4",
+  vec2: "DEBUG_VEC2",
+  vec3: "DEBUG_VEC3",
+  vec4: "DEBUG_VEC4",
+  quat: "DEBUG_VEC4",
+  quat4: "DEBUG_VEC4",
+  mat3: "DEBUG_MAT3"
+};
+
+function getParamTypes(comment) {
+  let types = {};
+  let rx = /@param\s+\{(\w+)\}\s+(\[?)(\w+)/g;
+  let match = null;
+  while ((match = rx.exec(comment)) !== null) {
+    types[match[3]] = { type: match[1], optional: match[2] === "[" };
+  };
+  return types;
+};
+
+function getTag(type) {
+  return DEBUG_TAGS[type] || "DEBUG_ANY";
+};
+
+function isAllocation(decl) {
+  return /@returns? \{\w+\} a new/i.test(decl.comment);
+};
+
+function isArrayAllocation(decl) {
+  return /@returns? \{Float32Array\} a new/i.test(decl.comment);
+};
+
+module.exports = {
+  profile: {
+    before: decl => [`PROFILE_ENTER(${decl.index});`],
+    after: decl => [`PROFILE_LEAVE(${decl.index});`]
+  },
+  debug: {
+    before: decl => {
+      let types = getParamTypes(decl.comment);
+      return decl.params.filter(param => param.pointer).map(param => {
+        let doc = types[param.name] || { type: decl.namespace, optional: false };
+        let tag = getTag(doc.type);
+        let macro = decl.name === "free" ? "DEBUG_FREE" : "DEBUG_CHECK";
+        let check = `${macro}(${decl.index}, "${param.name}", ${param.name}, ${tag});`;
+        // optional pointers may be null
+        return doc.optional ? `if (${param.name}) ${check}` : check;
+      });
+    },
+    after: decl => {
+      if (!isAllocation(decl)) return [];
+      let tag = getTag(decl.namespace);
+      // arrays are untyped, their elements can be passed anywhere
+      if (isArrayAllocation(decl)) {
+        return [`DEBUG_ALLOC_ARRAY(result, count, ${tag});`];
+      }
+      // opaque handles like a bvh
+      if (tag === "DEBUG_ANY") tag = "DEBUG_HANDLE";
+      return [`DEBUG_ALLOC(result, ${tag});`];
+    }
+  }
+};
@@ -0,0 +1,57 @@
+/**
+ * Rewrites the module sources for instrumented builds.
+ * Every export is split into a static implementation
+ * and an exported wrapper which runs the flavour's hooks
+ * around the call. Calls between modules are redirected
+ * to the implementations, so only calls coming
+ * from JavaScript pass through the hooks
+ */
+const parse = require("./parse");
+
+function emitWrapper(decl, hooks) {
+  let ret = decl.ret.trim();
+  let impl = decl.id + "__impl";
+  let args = decl.params.map(param => param.name).join(", ");
+  let before = [];
+  let after = [];
+  hooks.map(hook => {
+    if (hook.before) before.push(...hook.before(decl));
+    if (hook.after) after.unshift(...hook.after(decl));
+  });
+  let out = [];
+  out.push(`static ${decl.ret}${impl}(${decl.signature});`);
+  out.push(`export ${decl.ret}${decl.namespace}(${decl.name})(${decl.signature}) {`);
+  before.map(line => out.push("  " + line));
+  if (ret === "void") out.push(`  ${impl}(${args});`);
+  else out.push(`  ${decl.ret}result = ${impl}(${args});`);
+  after.map(line => out.push("  " + line));
+  if (ret !== "void") out.push(`  return result;`);
+  out.push(`};`);
+  out.push(`static ${decl.ret}${impl}(${decl.signature}) {`);
+  return out.join("\n");
+};
+
+/**
+ * @param {Object} files file name to source map
+ * @param {Array} hooks hook descriptors of the flavour
+ * @returns {Object} rewritten files and the export table
+ */
+module.exports = function(files, hooks) {
+  let names = Object.keys(files);
+  let namespaces = parse.getNamespaces(names.map(name => files[name]));
+  let callRx = new RegExp(`\\b(${namespaces.join("|")})\\((\\w+)\\)\\(`, "g");
+  let table = [];
+  let output = {};
+  names.map(file => {
+    let lines = parse.walk(files[file], (line, decl) => {
+      if (decl && namespaces.indexOf(decl.namespace) > -1) {
+        decl.index = table.length;
+        table.push(decl);
+        return emitWrapper(decl, hooks);
+      }
+      return line.replace(callRx, "$1_$2__impl(");
+    });
+    output[file] = lines.join("\n");
+  });
+  return { files: output, exports: table };
+};
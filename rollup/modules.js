@@ -0,0 +1,19 @@
+/**
+ * The modules of every build in include order, a module
+ * can only call into the modules listed before it
+ */
+module.exports = [
+  "vec3.c",
+  "vec4.c",
+  "mat4.c",
+  "array.c",
+  "intersect.c",
+  "aabb.c",
+  "bvh.c",
+  "billboard.c",
+  "rng.c",
+  "grid.c",
+  "physics.c",
+  "pack.c",
+  "codec.c"
+].concat(require("../src/gl-matrix/generated.json"));
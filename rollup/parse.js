@@ -0,0 +1,70 @@
+/**
+ * Minimal parser for the export declarations of the module sources.
+ * Exports are expected in the form of
+ * export float *vec3(add)(float *out, float *a, float *b) {
+ * preceded by their doc comment
+ */
+
+const EXPORT_RX = /^export (.*?)\b(\w+)\((\w+)\)\((.*)\) \{$/;
+const NAMESPACE_RX = /^#define (\w+)\(x\) \1_##x$/gm;
+
+function getNamespaces(sources) {
+  let namespaces = [];
+  sources.map(source => {
+    let match = null;
+    while ((match = NAMESPACE_RX.exec(source)) !== null) {
+      namespaces.push(match[1]);
+    };
+  });
+  return namespaces;
+};
+
+function parseParams(params) {
+  if (!params.trim().length) return [];
+  return params.split(",").map(param => {
+    param = param.trim();
+    return {
+      name: param.match(/(\w+)$/)[1],
+      pointer: param.indexOf("*") > -1,
+      source: param
+    };
+  });
+};
+
+/**
+ * Parses a single source line
+ *
+ * @returns {Object} the declaration or null
+ */
+function parseExport(line, comment) {
+  let match = line.match(EXPORT_RX);
+  if (!match) return null;
+  return {
+    ret: match[1],
+    namespace: match[2],
+    name: match[3],
+    id: match[2] + "_" + match[3],
+    signature: match[4],
+    params: parseParams(match[4]),
+    comment: comment
+  };
+};
+
+/**
+ * Calls fn for every line of a source, passing the
+ * export declared on it along with its doc comment
+ */
+function walk(source, fn) {
+  let comment = [];
+  return source.split("\n").map(line => {
+    if (line.match(/^\/\*\*/)) comment = [];
+    comment.push(line);
+    return fn(line, parseExport(line, comment.join("\n")));
+  });
+};
+
+module.exports = {
+  getNamespaces,
+  parseExport,
+  walk
+};
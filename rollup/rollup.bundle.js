@@ -26,14 +26,21 @@ config.plugins = [
 
 const outputOptions = {};
 
+const flavour = process.argv[2] || "release";
+// building with clang when a target (feature set) is given
+const target = process.argv[3];
+
 async function build() {
 
-  await wasm();
+  if (target) await require("./compile.clang")(flavour, target);
+  else await wasm(flavour);
 
   const bundle = await rollup.rollup(config);
 
   const { code, map } = await bundle.generate(config);
-  fs.writeFileSync("dist/glmw-browser.js", code, "utf-8");
+  let suffix = flavour !== "release" ? "-" + flavour : "";
+  if (target) suffix += "-" + target.replace(/,/g, "-");
+  fs.writeFileSync(`dist/glmw-browser${suffix}.js`, code, "utf-8");
 
 }
 
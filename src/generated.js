@@ -0,0 +1,8 @@
+// generated by interfaces/generate.js
+import vec2_bridge from "./gl-matrix/bridges/vec2.js";
+
+export let vec2 = {};
+
+export default [
+  { name: "vec2", module: vec2, bridge: vec2_bridge }
+];
@@ -0,0 +1,43 @@
+#include <webassembly.h>
+#include <math.h>
+#include "common.h"
+
+#define aabb(x) aabb_##x
+
+/**
+ * Transforms an array of axis-aligned bounding boxes, each by its
+ * own matrix, and writes the enclosing boxes (Arvo's method).
+ * Instead of transforming all 8 corners, every matrix element
+ * scales the minimum and maximum along its axis and the smaller
+ * and larger product are accumulated separately.
+ * The output arrays may be the input arrays
+ *
+ * @param {Float32Array} outMin receiving box minima (SoA)
+ * @param {Float32Array} outMax receiving box maxima (SoA)
+ * @param {Float32Array} min box minima (SoA)
+ * @param {Float32Array} max box maxima (SoA)
+ * @param {Float32Array} m array of mat4, one per box
+ * @param {Number} count amount of boxes
+ * @returns {Float32Array} outMin
+ */
+export float *aabb(transformMat4Array)(float *outMin, float *outMax, float *min, float *max, float *m, int count) {
+  for (int ii = 0; ii < count; ++ii) {
+    float *mat = m + ii * MAT_SIZE_4;
+    float lo[3] = { min[ii], min[ii + count], min[ii + count * 2] };
+    float hi[3] = { max[ii], max[ii + count], max[ii + count * 2] };
+    for (int row = 0; row < 3; ++row) {
+      float nmin = mat[12 + row];
+      float nmax = mat[12 + row];
+      for (int col = 0; col < 3; ++col) {
+        float e = mat[col * 4 + row];
+        float a = e * lo[col];
+        float b = e * hi[col];
+        nmin += fminf(a, b);
+        nmax += fmaxf(a, b);
+      };
+      outMin[ii + count * row] = nmin;
+      outMax[ii + count * row] = nmax;
+    };
+  };
+  return outMin;
+};
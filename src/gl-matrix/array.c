@@ -0,0 +1,26 @@
+#include <webassembly.h>
+#include "common.h"
+
+#define array(x) array_##x
+
+/**
+ * Frees an array
+ */
+export float *array(free)(float *a) {
+  free(a);
+  return NULL;
+};
+
+/**
+ * Creates a new, zero-filled array of floats
+ * Bulk kernels expect vec3 data in structure of arrays layout:
+ * all x components first, followed by all y and all z components
+ *
+ * @param {Number} count amount of floats
+ * @returns {Float32Array} a new array
+ */
+export float *array(create)(int count) {
+  float *out = malloc(count * sizeof(*out));
+  for (int ii = 0; ii < count; ++ii) out[ii] = 0;
+  return out;
+};
@@ -0,0 +1,82 @@
+#include <webassembly.h>
+#include <math.h>
+#include "common.h"
+
+#define billboard(x) billboard_##x
+
+/**
+ * Camera-facing billboards for particle and sprite systems.
+ * Every billboard shares the camera's right and up vector,
+ * so instead of a targetTo per sprite the basis is computed
+ * once and only scaled and translated per particle.
+ * Positions are passed in structure of arrays layout (see array.create)
+ */
+
+/**
+ * Writes a packed 3x4 matrix for every particle. The matrices are
+ * stored row by row (12 floats), each row holds the scaled basis
+ * vector components of one axis followed by the position
+ *
+ * @param {Float32Array} out receiving 3x4 matrices
+ * @param {vec3} right camera right vector (world space)
+ * @param {vec3} up camera up vector (world space)
+ * @param {Float32Array} positions particle positions (SoA)
+ * @param {Float32Array} [sizes] half extents of the particles, 1 if omitted
+ * @param {Number} count amount of particles
+ * @returns {Float32Array} out
+ */
+export float *billboard(matrixArray)(float *out, float *right, float *up, float *positions, float *sizes, int count) {
+  float normal[3];
+  vec3(cross)(normal, right, up);
+  vec3(normalize)(normal, normal);
+  float *px = positions, *py = positions + count, *pz = positions + count * 2;
+  for (int ii = 0; ii < count; ++ii) {
+    float *m = out + ii * 12;
+    float size = sizes ? sizes[ii] : 1.0;
+    for (int row = 0; row < 3; ++row) {
+      m[row * 4 + 0] = right[row] * size;
+      m[row * 4 + 1] = up[row] * size;
+      m[row * 4 + 2] = normal[row] * size;
+    };
+    m[3] = px[ii];
+    m[7] = py[ii];
+    m[11] = pz[ii];
+  };
+  return out;
+};
+
+/**
+ * Writes the 4 corner vertices of every particle's quad into a vertex
+ * buffer, in counter-clockwise order starting at the bottom left corner.
+ * The position of a vertex is written to its first 3 floats, the others are
+ * left untouched, so a stride above 3 keeps interleaved attributes like uvs
+ *
+ * @param {Float32Array} out receiving vertex buffer
+ * @param {vec3} right camera right vector (world space)
+ * @param {vec3} up camera up vector (world space)
+ * @param {Float32Array} positions particle positions (SoA)
+ * @param {Float32Array} [sizes] half extents of the particles, 1 if omitted
+ * @param {Number} count amount of particles
+ * @param {Number} stride floats between the vertices, 0 for tightly packed
+ * @returns {Float32Array} out
+ */
+export float *billboard(quadArray)(float *out, float *right, float *up, float *positions, float *sizes, int count, int stride) {
+  // corner offsets along right and up
+  float const cornerX[4] = { -1, 1, 1, -1 };
+  float const cornerY[4] = { -1, -1, 1, 1 };
+  float *px = positions, *py = positions + count, *pz = positions + count * 2;
+  if (!stride) stride = VEC_SIZE_3;
+  for (int ii = 0; ii < count; ++ii) {
+    float size = sizes ? sizes[ii] : 1.0;
+    float rx = right[0] * size, ry = right[1] * size, rz = right[2] * size;
+    float ux = up[0] * size, uy = up[1] * size, uz = up[2] * size;
+    float *v = out + ii * 4 * stride;
+    for (int jj = 0; jj < 4; ++jj, v += stride) {
+      float cx = cornerX[jj], cy = cornerY[jj];
+      v[0] = px[ii] + rx * cx + ux * cy;
+      v[1] = py[ii] + ry * cx + uy * cy;
+      v[2] = pz[ii] + rz * cx + uz * cy;
+    };
+  };
+  return out;
+};
@@ -0,0 +1,36 @@
+/**
+ * The following methods need to be bridged
+ * within js which results in some overhead
+ */
+export default function(module, memory) {
+  // @view
+  module.view = function(address, count) {
+    return memory.F32.subarray(address >> 2, (address >> 2) + count);
+  };
+  // @viewInt
+  module.viewInt = function(address, count) {
+    return memory.I32.subarray(address >> 2, (address >> 2) + count);
+  };
+  // @viewI16
+  module.viewI16 = function(address, count) {
+    return memory.I16.subarray(address >> 1, (address >> 1) + count);
+  };
+  // @viewU16
+  module.viewU16 = function(address, count) {
+    return memory.U16.subarray(address >> 1, (address >> 1) + count);
+  };
+  // @viewI8
+  module.viewI8 = function(address, count) {
+    return memory.I8.subarray(address, address + count);
+  };
+  // @viewU8
+  module.viewU8 = function(address, count) {
+    return memory.U8.subarray(address, address + count);
+  };
+  // @from
+  module.from = function(values) {
+    let address = module.create(values.length);
+    memory.F32.set(values, address >> 2);
+    return address;
+  };
+};
@@ -0,0 +1,11 @@
+/**
+ * The allocation table is only compiled into the debug build,
+ * in any other build the methods are no-ops
+ */
+export default function(module, memory) {
+  module.enabled = typeof module.live === "function";
+  if (!module.enabled) {
+    module.live = () => 0;
+    module.bytes = () => 0;
+  }
+};
@@ -19,6 +19,11 @@ export default function(module, memory) {
     //view.address = address;
     return view;
   };
+  // @copyFrom
+  module.copyFrom = function(address, values) {
+    memory.F32.set(values, address >> 2);
+    return address;
+  };
   // @exactEquals
   let _exactEquals = module.exactEquals;
   module.exactEquals = function(a, b) {
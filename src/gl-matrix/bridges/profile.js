@@ -0,0 +1,42 @@
+import { readString } from "../../utils";
+
+/**
+ * The profiler is only compiled into the profiling build,
+ * in any other build the methods are no-ops
+ */
+export default function(module, memory) {
+  module.enabled = typeof module.count === "function";
+  if (!module.enabled) {
+    module.count = () => 0;
+    module.reset = () => 0;
+    module.timing = () => false;
+  }
+  // @timing
+  let _timing = module.timing;
+  module.timing = function(enabled) {
+    return !!_timing(enabled ? 1 : 0);
+  };
+  // @name
+  let _name = module.name;
+  module.name = function(id) {
+    return readString(memory, _name(id));
+  };
+  // @report
+  module.report = function() {
+    let out = [];
+    let count = module.count();
+    for (let ii = 0; ii < count; ++ii) {
+      let calls = module.calls(ii);
+      if (calls <= 0) continue;
+      let time = module.time(ii);
+      out.push({
+        name: module.name(ii),
+        calls: calls,
+        time: time,
+        average: time / calls
+      });
+    };
+    out.sort((a, b) => (b.time - a.time) || (b.calls - a.calls));
+    return out;
+  };
+};
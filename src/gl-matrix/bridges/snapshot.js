@@ -0,0 +1,64 @@
+/**
+ * Snapshots of the whole WebAssembly heap. Every object, the allocator's
+ * bookkeeping and the globals of the module (e.g. the random streams or
+ * the debug build's allocation table) live in linear memory, so copying
+ * its used part captures the complete state. A snapshot consists of a
+ * 16 byte header (magic, version, build fingerprint, length) followed by
+ * the memory up to the allocator's high-water mark and can only be
+ * restored into an instance of the same build. The native and clang
+ * builds export that mark as snapshot_top, for the others the memory
+ * is scanned for its last non-zero word
+ */
+const MAGIC = 0x574D4C47; // "GLMW"
+const VERSION = 1;
+const HEADER_SIZE = 16;
+const PAGE_SIZE = 65536;
+
+export default function(module, memory) {
+  // @save
+  module.save = function() {
+    let length = 0;
+    if (module.top) {
+      length = (module.top() + 3) & ~3;
+    } else {
+      // the heap grows upwards, skip the untouched memory above it
+      let I32 = memory.I32;
+      let end = I32.length;
+      while (end > 0 && I32[end - 1] === 0) end--;
+      length = end << 2;
+    }
+    let out = new Uint8Array(HEADER_SIZE + length);
+    let header = new DataView(out.buffer);
+    header.setUint32(0, MAGIC, true);
+    header.setUint32(4, VERSION, true);
+    header.setUint32(8, memory.fingerprint, true);
+    header.setUint32(12, length, true);
+    out.set(memory.U8.subarray(0, length), HEADER_SIZE);
+    return out;
+  };
+  // @restore
+  module.restore = function(snapshot) {
+    let header = new DataView(snapshot.buffer, snapshot.byteOffset, snapshot.byteLength);
+    if (snapshot.byteLength < HEADER_SIZE || header.getUint32(0, true) !== MAGIC) {
+      throw new Error(`Invalid snapshot`);
+    }
+    if (header.getUint32(4, true) !== VERSION) {
+      throw new Error(`Unsupported snapshot version ${header.getUint32(4, true)}`);
+    }
+    if (header.getUint32(8, true) !== memory.fingerprint) {
+      throw new Error(`Snapshot was taken with a different build`);
+    }
+    let length = header.getUint32(12, true);
+    if (snapshot.byteLength < HEADER_SIZE + length) {
+      throw new Error(`Truncated snapshot`);
+    }
+    let pages = Math.ceil(length / PAGE_SIZE);
+    let current = memory.buffer.byteLength / PAGE_SIZE;
+    if (pages > current) {
+      memory.grow(pages - current);
+      memory.update();
+    }
+    memory.U8.set(snapshot.subarray(HEADER_SIZE, HEADER_SIZE + length));
+    memory.U8.fill(0, length);
+  };
+};
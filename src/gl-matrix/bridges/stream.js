@@ -0,0 +1,103 @@
+/**
+ * Streaming of datasets larger than WebAssembly's memory. The chunks
+ * of a source are copied into a ring of preallocated slots, processed
+ * in place by a kernel and handed out as views into the slot. Only the
+ * ring lives in memory, so the peak usage is slots * chunkSize floats
+ * no matter how large the dataset is. The next source chunk is requested
+ * before a result is handed out, so reading overlaps with the consumer.
+ * A result stays valid until slots - 1 further results were handed out
+ * or memory grows, pass copy: true to receive copies instead. The returned
+ * object implements the async iterator protocol by hand, so it needs no
+ * generator support and can be driven with next() where for await is missing
+ */
+const CHUNK_SIZE = 1 << 20;
+const SLOTS = 2;
+
+export default function(module, memory, array, vec3) {
+  // @map
+  module.map = function(source, kernel, options = {}) {
+    let stride = options.stride || 1;
+    let chunkSize = options.chunkSize || CHUNK_SIZE;
+    let size = Math.max(stride, chunkSize - chunkSize % stride);
+    let ring = [];
+    for (let ii = 0; ii < (options.slots || SLOTS); ++ii) ring.push(array.create(size));
+    let isAsync = typeof Symbol.asyncIterator !== "undefined" && source[Symbol.asyncIterator];
+    let iterator = isAsync ? source[Symbol.asyncIterator]() : source[Symbol.iterator]();
+    let slot = 0;
+    let length = 0;
+    let chunk = null;
+    let offset = 0;
+    let finished = false;
+    let closed = false;
+    let pending = null;
+    let queue = Promise.resolve();
+    // processes the filled slot and carries a partial element over into the next one
+    let flush = function() {
+      let address = ring[slot];
+      let count = length - length % stride;
+      kernel(address, count / stride);
+      let view = memory.F32.subarray(address >> 2, (address >> 2) + count);
+      slot = (slot + 1) % ring.length;
+      let rest = length - count;
+      memory.F32.copyWithin(ring[slot] >> 2, (address >> 2) + count, (address >> 2) + length);
+      length = rest;
+      return options.copy ? view.slice() : view;
+    };
+    // frees the ring and lets an unfinished source release its resources
+    let close = function() {
+      if (closed) return Promise.resolve();
+      closed = true;
+      ring.forEach(address => array.free(address));
+      return Promise.resolve(!finished && iterator.return ? iterator.return() : undefined);
+    };
+    let pull = function() {
+      if (closed) return Promise.resolve({ value: undefined, done: true });
+      while (chunk !== null && offset < chunk.length) {
+        let take = Math.min(size - length, chunk.length - offset);
+        memory.F32.set(chunk.subarray(offset, offset + take), (ring[slot] >> 2) + length);
+        length += take;
+        offset += take;
+        if (length === size) return Promise.resolve({ value: flush(), done: false });
+      };
+      chunk = null;
+      if (finished) {
+        // a trailing partial element is dropped
+        if (length >= stride) return Promise.resolve({ value: flush(), done: false });
+        return close().then(() => ({ value: undefined, done: true }));
+      }
+      if (pending === null) pending = iterator.next();
+      return Promise.resolve(pending).then(result => {
+        if (result.done) finished = true;
+        else {
+          chunk = result.value;
+          offset = 0;
+          // request the next chunk before handing out results of this one
+          pending = iterator.next();
+        }
+        return pull();
+      });
+    };
+    // calls are chained, so a step never starts before the previous one settled
+    let run = function(step) {
+      let result = queue.then(step);
+      queue = result.catch(() => {});
+      return result;
+    };
+    let out = {
+      next: function() {
+        return run(() => Promise.resolve().then(pull).catch(error => close().then(() => Promise.reject(error))));
+      },
+      return: function(value) {
+        return run(() => close().then(() => ({ value: value, done: true })));
+      }
+    };
+    if (typeof Symbol.asyncIterator !== "undefined") out[Symbol.asyncIterator] = () => out;
+    return out;
+  };
+  // @transformMat4
+  module.transformMat4 = function(source, m, options = {}) {
+    return module.map(source, (address, count) => {
+      vec3.transformMat4Array(address, address, m, count, 0, 0);
+    }, Object.assign({}, options, { stride: 3 }));
+  };
+};
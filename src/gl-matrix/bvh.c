@@ -0,0 +1,414 @@
+#include <webassembly.h>
+#include <math.h>
+#include "common.h"
+
+#define bvh(x) bvh_##x
+
+/**
+ * Bounding volume hierarchy over arrays of axis-aligned
+ * bounding boxes in structure of arrays layout.
+ * Nodes are stored linearly, the two children of a node
+ * are always adjacent and placed after their parent
+ */
+
+#define BVH_BINS 16
+#define BVH_TRAVERSAL_COST 1.0
+
+typedef struct {
+  float min[3];
+  // index of the left child, or of the first primitive for leaves
+  int first;
+  float max[3];
+  // amount of primitives, 0 for inner nodes
+  int count;
+} BvhNode;
+
+typedef struct {
+  BvhNode *nodes;
+  int *indices;
+  int *stack;
+  float *min;
+  float *max;
+  int count;
+  int nodeCount;
+} Bvh;
+
+typedef struct {
+  float min[3];
+  float max[3];
+  int count;
+} BvhBin;
+
+void bvhEmpty(float *min, float *max) {
+  min[0] = min[1] = min[2] = INFINITY;
+  max[0] = max[1] = max[2] = -INFINITY;
+};
+
+float bvhArea(float *min, float *max) {
+  float x = max[0] - min[0];
+  float y = max[1] - min[1];
+  float z = max[2] - min[2];
+  if (x < 0 || y < 0 || z < 0) return 0;
+  return x * y + y * z + z * x;
+};
+
+void bvhGrow(float *min, float *max, float *bmin, float *bmax) {
+  vec3(min)(min, min, bmin);
+  vec3(max)(max, max, bmax);
+};
+
+void bvhFit(Bvh *bvh, BvhNode *node) {
+  int count = bvh->count;
+  float *min = bvh->min;
+  float *max = bvh->max;
+  bvhEmpty(node->min, node->max);
+  for (int ii = 0; ii < node->count; ++ii) {
+    int index = bvh->indices[node->first + ii];
+    node->min[0] = fminf(node->min[0], min[index]);
+    node->min[1] = fminf(node->min[1], min[index + count]);
+    node->min[2] = fminf(node->min[2], min[index + count * 2]);
+    node->max[0] = fmaxf(node->max[0], max[index]);
+    node->max[1] = fmaxf(node->max[1], max[index + count]);
+    node->max[2] = fmaxf(node->max[2], max[index + count * 2]);
+  };
+};
+
+float bvhCentroid(Bvh *bvh, int index, int axis) {
+  int offset = index + bvh->count * axis;
+  return (bvh->min[offset] + bvh->max[offset]) * 0.5;
+};
+
+/**
+ * Finds the cheapest binned SAH split of a node
+ *
+ * @returns {Number} cost of the split, axis and position are written out
+ */
+float bvhFindSplit(Bvh *bvh, BvhNode *node, int *outAxis, float *outSplit) {
+  int count = bvh->count;
+  float best = INFINITY;
+  BvhBin bins[BVH_BINS];
+  float leftArea[BVH_BINS - 1];
+  int leftCount[BVH_BINS - 1];
+  for (int axis = 0; axis < 3; ++axis) {
+    float lo = INFINITY, hi = -INFINITY;
+    for (int ii = 0; ii < node->count; ++ii) {
+      float c = bvhCentroid(bvh, bvh->indices[node->first + ii], axis);
+      lo = fminf(lo, c);
+      hi = fmaxf(hi, c);
+    };
+    if (lo == hi) continue;
+    float scale = BVH_BINS / (hi - lo);
+    for (int ii = 0; ii < BVH_BINS; ++ii) {
+      bvhEmpty(bins[ii].min, bins[ii].max);
+      bins[ii].count = 0;
+    };
+    for (int ii = 0; ii < node->count; ++ii) {
+      int index = bvh->indices[node->first + ii];
+      int bin = (int) ((bvhCentroid(bvh, index, axis) - lo) * scale);
+      if (bin > BVH_BINS - 1) bin = BVH_BINS - 1;
+      float bmin[3] = { bvh->min[index], bvh->min[index + count], bvh->min[index + count * 2] };
+      float bmax[3] = { bvh->max[index], bvh->max[index + count], bvh->max[index + count * 2] };
+      bvhGrow(bins[bin].min, bins[bin].max, bmin, bmax);
+      bins[bin].count++;
+    };
+    // sweep from the left, then from the right
+    float min[3], max[3];
+    int sum = 0;
+    bvhEmpty(min, max);
+    for (int ii = 0; ii < BVH_BINS - 1; ++ii) {
+      sum += bins[ii].count;
+      bvhGrow(min, max, bins[ii].min, bins[ii].max);
+      leftCount[ii] = sum;
+      leftArea[ii] = bvhArea(min, max);
+    };
+    sum = 0;
+    bvhEmpty(min, max);
+    for (int ii = BVH_BINS - 1; ii > 0; --ii) {
+      sum += bins[ii].count;
+      bvhGrow(min, max, bins[ii].min, bins[ii].max);
+      float cost = leftCount[ii - 1] * leftArea[ii - 1] + sum * bvhArea(min, max);
+      if (leftCount[ii - 1] > 0 && sum > 0 && cost < best) {
+        best = cost;
+        *outAxis = axis;
+        *outSplit = lo + ii / scale;
+      }
+    };
+  };
+  return best;
+};
+
+/**
+ * Builds a bvh over an array of bounding boxes. The arrays are
+ * referenced and must stay alive as long as the bvh is used
+ *
+ * @param {Float32Array} min box minima (SoA)
+ * @param {Float32Array} max box maxima (SoA)
+ * @param {Number} count amount of boxes
+ * @returns {bvh} a new bvh
+ */
+export Bvh *bvh(create)(float *min, float *max, int count) {
+  Bvh *out = malloc(sizeof(Bvh));
+  int capacity = count > 0 ? count * 2 - 1 : 1;
+  int *depths = malloc(capacity * sizeof(int));
+  int depth = 0;
+  out->nodes = malloc(capacity * sizeof(BvhNode));
+  out->indices = malloc((count > 0 ? count : 1) * sizeof(int));
+  out->min = min;
+  out->max = max;
+  out->count = count;
+  for (int ii = 0; ii < count; ++ii) out->indices[ii] = ii;
+  out->nodes[0].first = 0;
+  out->nodes[0].count = count;
+  out->nodeCount = 1;
+  depths[0] = 0;
+  // nodes are appended in order, so the node list doubles as work queue
+  for (int ii = 0; ii < out->nodeCount; ++ii) {
+    BvhNode *node = &out->nodes[ii];
+    bvhFit(out, node);
+    if (depths[ii] > depth) depth = depths[ii];
+    if (node->count <= 2) continue;
+    int axis = 0;
+    float split = 0;
+    float cost = bvhFindSplit(out, node, &axis, &split);
+    if (cost + BVH_TRAVERSAL_COST * bvhArea(node->min, node->max) >= node->count * bvhArea(node->min, node->max)) continue;
+    // partition the primitives around the split
+    int lo = node->first;
+    int hi = node->first + node->count - 1;
+    while (lo <= hi) {
+      if (bvhCentroid(out, out->indices[lo], axis) < split) {
+        lo++;
+      } else {
+        int swap = out->indices[lo];
+        out->indices[lo] = out->indices[hi];
+        out->indices[hi--] = swap;
+      }
+    };
+    int leftCount = lo - node->first;
+    if (leftCount == 0 || leftCount == node->count) continue;
+    int left = out->nodeCount;
+    out->nodes[left].first = node->first;
+    out->nodes[left].count = leftCount;
+    out->nodes[left + 1].first = lo;
+    out->nodes[left + 1].count = node->count - leftCount;
+    depths[left] = depths[left + 1] = depths[ii] + 1;
+    node->first = left;
+    node->count = 0;
+    out->nodeCount += 2;
+  };
+  free(depths);
+  out->stack = malloc((depth + 2) * sizeof(int));
+  return out;
+};
+
+/**
+ * Frees a bvh
+ */
+export Bvh *bvh(free)(Bvh *bvh) {
+  free(bvh->nodes);
+  free(bvh->indices);
+  free(bvh->stack);
+  free(bvh);
+  return NULL;
+};
+
+/**
+ * Updates all node bounds after the referenced boxes changed.
+ * The topology is kept, so the bvh degrades if the boxes move a lot
+ *
+ * @param {bvh} bvh the bvh to refit
+ * @returns {bvh} bvh
+ */
+export Bvh *bvh(refit)(Bvh *bvh) {
+  // children are always stored after their parent
+  for (int ii = bvh->nodeCount - 1; ii >= 0; --ii) {
+    BvhNode *node = &bvh->nodes[ii];
+    if (node->count > 0 || bvh->count == 0) {
+      bvhFit(bvh, node);
+    } else {
+      BvhNode *left = &bvh->nodes[node->first];
+      BvhNode *right = left + 1;
+      vec3(min)(node->min, left->min, right->min);
+      vec3(max)(node->max, left->max, right->max);
+    }
+  };
+  return bvh;
+};
+
+float bvhRayBox(float *min, float *max, float *origin, float *inv, float far) {
+  float tx0 = (min[0] - origin[0]) * inv[0], tx1 = (max[0] - origin[0]) * inv[0];
+  float ty0 = (min[1] - origin[1]) * inv[1], ty1 = (max[1] - origin[1]) * inv[1];
+  float tz0 = (min[2] - origin[2]) * inv[2], tz1 = (max[2] - origin[2]) * inv[2];
+  float tmin = fmaxf(fmaxf(fminf(tx0, tx1), fminf(ty0, ty1)), fmaxf(fminf(tz0, tz1), 0));
+  float tmax = fminf(fminf(fmaxf(tx0, tx1), fmaxf(ty0, ty1)), fmaxf(tz0, tz1));
+  return tmin <= tmax && tmin < far ? tmin : INFINITY;
+};
+
+/**
+ * Finds the nearest box hit by a ray
+ *
+ * @param {Float32Array} out receives the distance to the nearest hit
+ * @param {bvh} bvh the bvh to traverse
+ * @param {vec3} origin ray origin
+ * @param {vec3} dir ray direction
+ * @param {Number} far maximum hit distance
+ * @returns {Number} index of the nearest box or -1
+ */
+export int bvh(raycast)(float *out, Bvh *bvh, float *origin, float *dir, float far) {
+  int count = bvh->count;
+  int *stack = bvh->stack;
+  int top = 0;
+  int nearest = -1;
+  float inv[VEC_SIZE_3];
+  float min[VEC_SIZE_3], max[VEC_SIZE_3];
+  vec3(inverse)(inv, dir);
+  if (count > 0) stack[top++] = 0;
+  while (top > 0) {
+    BvhNode *node = &bvh->nodes[stack[--top]];
+    if (bvhRayBox(node->min, node->max, origin, inv, far) == INFINITY) continue;
+    if (node->count > 0) {
+      for (int ii = 0; ii < node->count; ++ii) {
+        int index = bvh->indices[node->first + ii];
+        min[0] = bvh->min[index]; min[1] = bvh->min[index + count]; min[2] = bvh->min[index + count * 2];
+        max[0] = bvh->max[index]; max[1] = bvh->max[index + count]; max[2] = bvh->max[index + count * 2];
+        float t = bvhRayBox(min, max, origin, inv, far);
+        if (t < far) {
+          far = t;
+          nearest = index;
+        }
+      };
+      continue;
+    }
+    // visit the nearer child first
+    BvhNode *left = &bvh->nodes[node->first];
+    float tl = bvhRayBox(left->min, left->max, origin, inv, far);
+    float tr = bvhRayBox(left[1].min, left[1].max, origin, inv, far);
+    if (tl < tr) {
+      stack[top++] = node->first + 1;
+      stack[top++] = node->first;
+    } else {
+      stack[top++] = node->first;
+      stack[top++] = node->first + 1;
+    }
+  };
+  out[0] = far;
+  return nearest;
+};
+
+/**
+ * Collects the boxes overlapping a sphere
+ *
+ * @param {Int32Array} out receives the box indices
+ * @param {bvh} bvh the bvh to traverse
+ * @param {vec3} center sphere center
+ * @param {Number} radius sphere radius
+ * @param {Number} capacity maximum amount of indices to write
+ * @returns {Number} amount of indices written
+ */
+export int bvh(querySphere)(int *out, Bvh *bvh, float *center, float radius, int capacity) {
+  int count = bvh->count;
+  int *stack = bvh->stack;
+  int top = 0;
+  int length = 0;
+  float r2 = radius * radius;
+  if (count > 0) stack[top++] = 0;
+  while (top > 0 && length < capacity) {
+    BvhNode *node = &bvh->nodes[stack[--top]];
+    float dx = fmaxf(fmaxf(node->min[0] - center[0], center[0] - node->max[0]), 0);
+    float dy = fmaxf(fmaxf(node->min[1] - center[1], center[1] - node->max[1]), 0);
+    float dz = fmaxf(fmaxf(node->min[2] - center[2], center[2] - node->max[2]), 0);
+    if (dx * dx + dy * dy + dz * dz > r2) continue;
+    if (node->count > 0) {
+      for (int ii = 0; ii < node->count && length < capacity; ++ii) {
+        int index = bvh->indices[node->first + ii];
+        dx = fmaxf(fmaxf(bvh->min[index] - center[0], center[0] - bvh->max[index]), 0);
+        dy = fmaxf(fmaxf(bvh->min[index + count] - center[1], center[1] - bvh->max[index + count]), 0);
+        dz = fmaxf(fmaxf(bvh->min[index + count * 2] - center[2], center[2] - bvh->max[index + count * 2]), 0);
+        if (dx * dx + dy * dy + dz * dz <= r2) out[length++] = index;
+      };
+      continue;
+    }
+    stack[top++] = node->first + 1;
+    stack[top++] = node->first;
+  };
+  return length;
+};
+
+int bvhOutsidePlanes(float *planes, float *min, float *max) {
+  for (int ii = 0; ii < 24; ii += 4) {
+    float a = planes[ii], b = planes[ii + 1], c = planes[ii + 2];
+    // test the box corner furthest along the plane normal
+    float x = a > 0 ? max[0] : min[0];
+    float y = b > 0 ? max[1] : min[1];
+    float z = c > 0 ? max[2] : min[2];
+    if (a * x + b * y + c * z + planes[ii + 3] < 0) return 1;
+  };
+  return 0;
+};
+
+int bvhFrustum(int *out, Bvh *bvh, float *m, int capacity, int zeroToOne) {
+  int count = bvh->count;
+  int *stack = bvh->stack;
+  int top = 0;
+  int length = 0;
+  float planes[24];
+  float min[VEC_SIZE_3], max[VEC_SIZE_3];
+  // extract the clip planes from the rows of the matrix
+  for (int ii = 0; ii < 3; ++ii) {
+    for (int jj = 0; jj < 4; ++jj) {
+      planes[ii * 8 + jj] = m[jj * 4 + 3] + m[jj * 4 + ii];
+      planes[ii * 8 + 4 + jj] = m[jj * 4 + 3] - m[jj * 4 + ii];
+    };
+  };
+  // with depth in [0, 1] the near plane is z >= 0 instead of z >= -w
+  if (zeroToOne) {
+    for (int jj = 0; jj < 4; ++jj) planes[16 + jj] = m[jj * 4 + 2];
+  }
+  if (count > 0) stack[top++] = 0;
+  while (top > 0 && length < capacity) {
+    BvhNode *node = &bvh->nodes[stack[--top]];
+    if (bvhOutsidePlanes(planes, node->min, node->max)) continue;
+    if (node->count > 0) {
+      for (int ii = 0; ii < node->count && length < capacity; ++ii) {
+        int index = bvh->indices[node->first + ii];
+        min[0] = bvh->min[index]; min[1] = bvh->min[index + count]; min[2] = bvh->min[index + count * 2];
+        max[0] = bvh->max[index]; max[1] = bvh->max[index + count]; max[2] = bvh->max[index + count * 2];
+        if (!bvhOutsidePlanes(planes, min, max)) out[length++] = index;
+      };
+      continue;
+    }
+    stack[top++] = node->first + 1;
+    stack[top++] = node->first;
+  };
+  return length;
+};
+
+/**
+ * Collects the boxes intersecting a view frustum. Expects clip space
+ * depth in [-1, 1] as produced by {@link mat4.perspective}, {@link mat4.ortho}
+ * and {@link mat4.perspectiveInfinite}, use {@link bvh.queryFrustumZO}
+ * for the [0, 1] projections
+ *
+ * @param {Int32Array} out receives the box indices
+ * @param {bvh} bvh the bvh to traverse
+ * @param {mat4} m view-projection matrix of the frustum
+ * @param {Number} capacity maximum amount of indices to write
+ * @returns {Number} amount of indices written
+ */
+export int bvh(queryFrustum)(int *out, Bvh *bvh, float *m, int capacity) {
+  return bvhFrustum(out, bvh, m, capacity, 0);
+};
+
+/**
+ * Same as {@link bvh.queryFrustum} for projections with clip space depth
+ * in [0, 1] ({@link mat4.perspectiveZO}, {@link mat4.orthoZO} and
+ * {@link mat4.perspectiveReverseZ})
+ *
+ * @param {Int32Array} out receives the box indices
+ * @param {bvh} bvh the bvh to traverse
+ * @param {mat4} m view-projection matrix of the frustum
+ * @param {Number} capacity maximum amount of indices to write
+ * @returns {Number} amount of indices written
+ */
+export int bvh(queryFrustumZO)(int *out, Bvh *bvh, float *m, int capacity) {
+  return bvhFrustum(out, bvh, m, capacity, 1);
+};
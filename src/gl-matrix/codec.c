@@ -0,0 +1,266 @@
+#include <webassembly.h>
+#include <math.h>
+#include "common.h"
+
+#define codec(x) codec_##x
+
+/**
+ * Quantized transform codec for network replication. Transforms are
+ * first quantized into a state of 7 integers each:
+ *  0-2 positions, fixed point within the bounds of the codec
+ *  3   rotation, smallest three: the index of the largest quaternion
+ *      component in the lowest 2 bits, followed by the other three
+ *  4-6 scalings, fixed point within [-maxScale, maxScale]
+ * States are then written as a bit stream of deltas against a baseline
+ * state, usually the last one acknowledged by the receiver.
+ * Unchanged transforms cost 1 bit, unchanged components 1 bit more
+ * and small changes 10 bits
+ */
+
+#define CODEC_STATE_SIZE 7
+// zigzag deltas below this are written in CODEC_SMALL_BITS
+#define CODEC_SMALL_BITS 8
+#define CODEC_SMALL (1 << CODEC_SMALL_BITS)
+
+typedef struct {
+  float min[3];
+  float max[3];
+  float maxScale;
+  int positionBits;
+  int rotationBits;
+  int scaleBits;
+} Codec;
+
+typedef struct {
+  unsigned char *data;
+  int capacity;
+  int position;
+  unsigned long long bits;
+  int count;
+} CodecStream;
+
+void codecWrite(CodecStream *stream, unsigned int value, int bits) {
+  stream->bits |= (unsigned long long) value << stream->count;
+  stream->count += bits;
+  while (stream->count >= 8) {
+    if (stream->position < stream->capacity) stream->data[stream->position] = stream->bits & 0xFF;
+    stream->position++;
+    stream->bits >>= 8;
+    stream->count -= 8;
+  };
+};
+
+unsigned int codecRead(CodecStream *stream, int bits) {
+  while (stream->count < bits) {
+    unsigned int byte = stream->position < stream->capacity ? stream->data[stream->position] : 0;
+    stream->bits |= (unsigned long long) byte << stream->count;
+    stream->position++;
+    stream->count += 8;
+  };
+  unsigned int value = stream->bits & ((1ull << bits) - 1);
+  stream->bits >>= bits;
+  stream->count -= bits;
+  return value;
+};
+
+unsigned int codecQuantize(float value, float min, float max, int bits) {
+  unsigned int steps = (1u << bits) - 1;
+  float t = max > min ? (value - min) / (max - min) : 0;
+  t = fminf(fmaxf(t, 0.0), 1.0);
+  return (unsigned int) (t * steps + 0.5);
+};
+
+float codecDequantize(unsigned int value, float min, float max, int bits) {
+  unsigned int steps = (1u << bits) - 1;
+  return min + (max - min) * ((float) value / steps);
+};
+
+void codecWriteValue(CodecStream *stream, int value, int base, int bits) {
+  int delta = value - base;
+  unsigned int zigzag = ((unsigned int) delta << 1) ^ (unsigned int) (delta >> 31);
+  if (delta == 0) {
+    codecWrite(stream, 0, 1);
+  } else if (zigzag < CODEC_SMALL) {
+    codecWrite(stream, 1, 2);
+    codecWrite(stream, zigzag, CODEC_SMALL_BITS);
+  } else {
+    codecWrite(stream, 3, 2);
+    codecWrite(stream, value, bits);
+  }
+};
+
+int codecReadValue(CodecStream *stream, int base, int bits) {
+  if (!codecRead(stream, 1)) return base;
+  if (!codecRead(stream, 1)) {
+    unsigned int zigzag = codecRead(stream, CODEC_SMALL_BITS);
+    return base + (int) ((zigzag >> 1) ^ -(zigzag & 1));
+  }
+  return codecRead(stream, bits);
+};
+
+/**
+ * Creates a new codec
+ *
+ * @param {vec3} min lower bound of all positions
+ * @param {vec3} max upper bound of all positions
+ * @param {Number} positionBits bits per position component, at most 24
+ * @param {Number} rotationBits bits per quaternion component, at most 10
+ * @param {Number} maxScale largest absolute scaling
+ * @param {Number} scaleBits bits per scaling component, at most 24
+ * @returns {codec} a new codec
+ */
+export Codec *codec(create)(float *min, float *max, int positionBits, int rotationBits, float maxScale, int scaleBits) {
+  Codec *out = malloc(sizeof(Codec));
+  for (int ii = 0; ii < 3; ++ii) {
+    out->min[ii] = min[ii];
+    out->max[ii] = max[ii];
+  };
+  out->maxScale = maxScale;
+  out->positionBits = positionBits < 1 ? 1 : positionBits > 24 ? 24 : positionBits;
+  out->rotationBits = rotationBits < 2 ? 2 : rotationBits > 10 ? 10 : rotationBits;
+  out->scaleBits = scaleBits < 1 ? 1 : scaleBits > 24 ? 24 : scaleBits;
+  return out;
+};
+
+/**
+ * Frees a codec
+ */
+export Codec *codec(free)(Codec *codec) {
+  free(codec);
+  return NULL;
+};
+
+/**
+ * Decomposes matrices and quantizes them into states
+ *
+ * @param {Int32Array} out receiving states, 7 integers per transform
+ * @param {codec} codec the codec
+ * @param {Float32Array} mats the transforms (mat4)
+ * @param {Number} count amount of transforms
+ * @returns {Int32Array} out
+ */
+export int *codec(quantizeArray)(int *out, Codec *codec, float *mats, int count) {
+  float t[3], q[4], s[3];
+  int bits = codec->rotationBits;
+  float range = 0.70710678;
+  for (int ii = 0; ii < count; ++ii) {
+    unsigned int *state = (unsigned int *) out + ii * CODEC_STATE_SIZE;
+    mat4(decompose)(t, q, s, mats + ii * MAT_SIZE_4);
+    int largest = 0;
+    for (int jj = 1; jj < 4; ++jj) {
+      if (fabsf(q[jj]) > fabsf(q[largest])) largest = jj;
+    };
+    // q and -q are the same rotation, keep the largest positive
+    float sign = q[largest] < 0 ? -1.0 : 1.0;
+    unsigned int rotation = largest;
+    for (int jj = 0, shift = 2; jj < 4; ++jj) {
+      if (jj == largest) continue;
+      rotation |= codecQuantize(q[jj] * sign, -range, range, bits) << shift;
+      shift += bits;
+    };
+    for (int jj = 0; jj < 3; ++jj) {
+      state[jj] = codecQuantize(t[jj], codec->min[jj], codec->max[jj], codec->positionBits);
+      state[4 + jj] = codecQuantize(s[jj], -codec->maxScale, codec->maxScale, codec->scaleBits);
+    };
+    state[3] = rotation;
+  };
+  return out;
+};
+
+/**
+ * Rebuilds matrices from quantized states
+ *
+ * @param {Float32Array} out receiving transforms (mat4)
+ * @param {codec} codec the codec
+ * @param {Int32Array} states the states, 7 integers per transform
+ * @param {Number} count amount of transforms
+ * @returns {Float32Array} out
+ */
+export float *codec(dequantizeArray)(float *out, Codec *codec, int *states, int count) {
+  float t[3], q[4], s[3];
+  int bits = codec->rotationBits;
+  unsigned int mask = (1u << bits) - 1;
+  float range = 0.70710678;
+  for (int ii = 0; ii < count; ++ii) {
+    unsigned int *state = (unsigned int *) states + ii * CODEC_STATE_SIZE;
+    unsigned int rotation = state[3];
+    int largest = rotation & 3;
+    float sum = 0;
+    for (int jj = 0, shift = 2; jj < 4; ++jj) {
+      if (jj == largest) continue;
+      q[jj] = codecDequantize((rotation >> shift) & mask, -range, range, bits);
+      sum += q[jj] * q[jj];
+      shift += bits;
+    };
+    q[largest] = sqrtf(fmaxf(1.0 - sum, 0.0));
+    for (int jj = 0; jj < 3; ++jj) {
+      t[jj] = codecDequantize(state[jj], codec->min[jj], codec->max[jj], codec->positionBits);
+      s[jj] = codecDequantize(state[4 + jj], -codec->maxScale, codec->maxScale, codec->scaleBits);
+    };
+    mat4(fromRotationTranslationScale)(out + ii * MAT_SIZE_4, q, t, s);
+  };
+  return out;
+};
+
+/**
+ * Writes states as deltas against a baseline into a byte buffer
+ *
+ * @param {Uint8Array} out receiving bytes
+ * @param {codec} codec the codec
+ * @param {Int32Array} states the states to send
+ * @param {Int32Array} [baseline] the states known to the receiver, all zero if omitted
+ * @param {Number} count amount of transforms
+ * @param {Number} capacity size of out in bytes
+ * @returns {Number} amount of bytes written, -1 if out was too small
+ */
+export int codec(encodeArray)(unsigned char *out, Codec *codec, int *states, int *baseline, int count, int capacity) {
+  CodecStream stream = { out, capacity, 0, 0, 0 };
+  int rotationBits = 2 + 3 * codec->rotationBits;
+  int zero[CODEC_STATE_SIZE] = { 0 };
+  for (int ii = 0; ii < count; ++ii) {
+    int *state = states + ii * CODEC_STATE_SIZE;
+    int *base = baseline ? baseline + ii * CODEC_STATE_SIZE : zero;
+    int changed = 0;
+    for (int jj = 0; jj < CODEC_STATE_SIZE; ++jj) changed |= state[jj] != base[jj];
+    codecWrite(&stream, changed, 1);
+    if (!changed) continue;
+    for (int jj = 0; jj < 3; ++jj) codecWriteValue(&stream, state[jj], base[jj], codec->positionBits);
+    codecWrite(&stream, state[3] != base[3], 1);
+    if (state[3] != base[3]) codecWrite(&stream, state[3], rotationBits);
+    for (int jj = 4; jj < 7; ++jj) codecWriteValue(&stream, state[jj], base[jj], codec->scaleBits);
+  };
+  // flush the last partial byte
+  if (stream.count > 0) codecWrite(&stream, 0, 8 - stream.count);
+  return stream.position <= capacity ? stream.position : -1;
+};
+
+/**
+ * Reads states written by {@link codec.encodeArray}
+ *
+ * @param {Int32Array} out receiving states
+ * @param {codec} codec the codec
+ * @param {Uint8Array} data the received bytes
+ * @param {Int32Array} [baseline] the baseline the sender used, all zero if omitted
+ * @param {Number} count amount of transforms
+ * @param {Number} length size of data in bytes
+ * @returns {Number} amount of bytes read, -1 if data was too short
+ */
+export int codec(decodeArray)(int *out, Codec *codec, unsigned char *data, int *baseline, int count, int length) {
+  CodecStream stream = { data, length, 0, 0, 0 };
+  int rotationBits = 2 + 3 * codec->rotationBits;
+  int zero[CODEC_STATE_SIZE] = { 0 };
+  for (int ii = 0; ii < count; ++ii) {
+    int *state = out + ii * CODEC_STATE_SIZE;
+    int *base = baseline ? baseline + ii * CODEC_STATE_SIZE : zero;
+    if (!codecRead(&stream, 1)) {
+      for (int jj = 0; jj < CODEC_STATE_SIZE; ++jj) state[jj] = base[jj];
+      continue;
+    }
+    for (int jj = 0; jj < 3; ++jj) state[jj] = codecReadValue(&stream, base[jj], codec->positionBits);
+    state[3] = codecRead(&stream, 1) ? (int) codecRead(&stream, rotationBits) : base[3];
+    for (int jj = 4; jj < 7; ++jj) state[jj] = codecReadValue(&stream, base[jj], codec->scaleBits);
+  };
+  // the stream is consumed in whole bytes
+  int read = stream.position - stream.count / 8;
+  return read <= length ? read : -1;
+};
@@ -3,7 +3,8 @@
 #ifndef FOO_H_
 #define FOO_H_
 
-import float randf();
+// default stream of rng.c
+float randf();
 
 float const PI = 3.141592653589793;
 
@@ -15,7 +16,75 @@ float toRadian(a) {
 
 float const EPSILON = 0.000001;
 
+/**
+ * Math used by normalize, rotate and random. The fast math build
+ * (GLMW_FAST_MATH) replaces it with approximations, measured bounds:
+ *  INVSQRT  relative error below 5e-6 (bit trick, 2 newton steps)
+ *  SQRT     relative error below 5e-6, 0 stays 0
+ *  SIN/COS  absolute error below 4e-6 for |x| < 2*PI and below 6e-6
+ *           for |x| < 100, growing with the magnitude of x due to the
+ *           float range reduction
+ */
+#ifdef GLMW_FAST_MATH
+
+#include <math.h>
+
+float fastInvSqrt(float x) {
+  union { float f; unsigned int i; } v = { x };
+  float half = x * 0.5f;
+  v.i = 0x5f375a86 - (v.i >> 1);
+  v.f *= 1.5f - half * v.f * v.f;
+  v.f *= 1.5f - half * v.f * v.f;
+  return v.f;
+};
+
+float fastSqrt(float x) {
+  return x * fastInvSqrt(x);
+};
+
+// reduces x to [-PI, PI]
+float fastReduce(float x) {
+  float k = x * (0.5f / PI);
+  return x - floorf(k + 0.5f) * (2.0f * PI);
+};
+
+// sine of a reduced x
+float fastSinReduced(float x) {
+  // mirror into [-PI/2, PI/2]
+  if (x > 0.5f * PI) x = PI - x;
+  else if (x < -0.5f * PI) x = -PI - x;
+  // taylor series up to x^9
+  float x2 = x * x;
+  return x * (1.0f + x2 * (-1.6666667e-1f + x2 * (8.3333333e-3f + x2 * (-1.9841270e-4f + x2 * 2.7557319e-6f))));
+};
+
+float fastSin(float x) {
+  return fastSinReduced(fastReduce(x));
+};
+
+float fastCos(float x) {
+  // shift after reducing, adding PI/2 to a large x would round it
+  x = fastReduce(x) + 0.5f * PI;
+  if (x > PI) x -= 2.0f * PI;
+  return fastSinReduced(x);
+};
+
+#define INVSQRT(x) fastInvSqrt(x)
+#define SQRT(x) fastSqrt(x)
+#define SIN(x) fastSin(x)
+#define COS(x) fastCos(x)
+
+#else
+
+#define INVSQRT(x) (1.0 / sqrtf(x))
+#define SQRT(x) sqrtf(x)
+#define SIN(x) sinf(x)
+#define COS(x) cosf(x)
+
+#endif
+
 // sizes
+int const VEC_SIZE_2 = 2;
 int const VEC_SIZE_3 = 3;
 int const VEC_SIZE_4 = 4;
 int const MAT_SIZE_4 = 4 * 4;
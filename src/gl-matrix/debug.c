@@ -0,0 +1,174 @@
+#include <webassembly.h>
+#include "common.h"
+
+#define debug(x) debug_##x
+
+/**
+ * Runtime of the debug build. Every allocation is tracked
+ * in a table sorted by address, so pointers handed in by
+ * the hooks of rollup/instrument.js can be validated
+ * against the live allocations and their types
+ */
+
+import void debugViolation(char const *name, char const *param, int reason, void *address);
+
+// allocation tags
+#define DEBUG_ANY 0
+#define DEBUG_VEC3 1
+#define DEBUG_VEC4 2
+#define DEBUG_MAT3 3
+#define DEBUG_MAT4 4
+// opaque structures, they are read by their free export
+#define DEBUG_HANDLE 5
+#define DEBUG_VEC2 6
+
+// violation reasons
+#define DEBUG_UNKNOWN 1
+#define DEBUG_FREED 2
+#define DEBUG_TYPE 3
+#define DEBUG_BOUNDS 4
+
+// bit pattern written into freed memory (a quiet NaN)
+#define DEBUG_POISON 0x7FC0DEAD
+
+typedef struct {
+  size_t address;
+  size_t size;
+  int tag;
+  int live;
+} DebugBlock;
+
+DebugBlock *debugBlocks = NULL;
+int debugCount = 0;
+int debugCapacity = 0;
+
+size_t debugSizeOf(int tag) {
+  switch (tag) {
+    case DEBUG_VEC2: return VEC_SIZE_2 * sizeof(float);
+    case DEBUG_VEC3: return VEC_SIZE_3 * sizeof(float);
+    case DEBUG_VEC4: return VEC_SIZE_4 * sizeof(float);
+    case DEBUG_MAT3: return 9 * sizeof(float);
+    case DEBUG_MAT4: return MAT_SIZE_4 * sizeof(float);
+  };
+  return sizeof(float);
+};
+
+/**
+ * Returns the index of the last block starting
+ * at or below the given address, or -1
+ */
+int debugFind(size_t address) {
+  int lo = 0;
+  int hi = debugCount - 1;
+  int found = -1;
+  while (lo <= hi) {
+    int mid = (lo + hi) >> 1;
+    if (debugBlocks[mid].address <= address) {
+      found = mid;
+      lo = mid + 1;
+    } else {
+      hi = mid - 1;
+    }
+  };
+  return found;
+};
+
+void debugReserve(int count) {
+  if (count <= debugCapacity) return;
+  int capacity = debugCapacity ? debugCapacity * 2 : 256;
+  while (capacity < count) capacity *= 2;
+  DebugBlock *blocks = malloc(capacity * sizeof(DebugBlock));
+  for (int ii = 0; ii < debugCount; ++ii) blocks[ii] = debugBlocks[ii];
+  if (debugBlocks) free(debugBlocks);
+  debugBlocks = blocks;
+  debugCapacity = capacity;
+};
+
+/**
+ * Registers a fresh allocation, dropping any freed
+ * blocks it now overlaps with
+ */
+void debugAlloc(void *ptr, size_t size, int tag) {
+  size_t address = (size_t) ptr;
+  if (!ptr) return;
+  int first = debugFind(address);
+  if (first < 0 || debugBlocks[first].address + debugBlocks[first].size <= address) first++;
+  int last = first;
+  while (last < debugCount && debugBlocks[last].address < address + size) last++;
+  int shift = 1 - (last - first);
+  debugReserve(debugCount + shift);
+  if (shift > 0) {
+    for (int ii = debugCount - 1; ii >= last; --ii) debugBlocks[ii + shift] = debugBlocks[ii];
+  } else if (shift < 0) {
+    for (int ii = last; ii < debugCount; ++ii) debugBlocks[ii + shift] = debugBlocks[ii];
+  }
+  debugCount += shift;
+  debugBlocks[first].address = address;
+  debugBlocks[first].size = size;
+  debugBlocks[first].tag = tag;
+  debugBlocks[first].live = 1;
+};
+
+/**
+ * Validates a pointer argument of an export
+ *
+ * @returns {Boolean} true if the pointer is valid
+ */
+int debugCheck(int id, char const *param, void *ptr, int tag) {
+  size_t address = (size_t) ptr;
+  size_t size = debugSizeOf(tag);
+  int index = debugFind(address);
+  DebugBlock *block = index > -1 ? &debugBlocks[index] : NULL;
+  int reason = 0;
+  if (!block || address >= block->address + block->size) reason = DEBUG_UNKNOWN;
+  else if (!block->live) reason = DEBUG_FREED;
+  else if (tag != DEBUG_ANY && block->tag != DEBUG_ANY && (block->tag != tag || address != block->address)) reason = DEBUG_TYPE;
+  else if (address + size > block->address + block->size) reason = DEBUG_BOUNDS;
+  if (reason) debugViolation(exportNames[id], param, reason, ptr);
+  return !reason;
+};
+
+/**
+ * Validates and poisons an allocation before it gets freed
+ *
+ * @returns {Boolean} true if the allocation can be freed
+ */
+int debugFree(int id, char const *param, void *ptr, int tag) {
+  if (!debugCheck(id, param, ptr, tag)) return 0;
+  DebugBlock *block = &debugBlocks[debugFind((size_t) ptr)];
+  unsigned int *data = (unsigned int *) ptr;
+  if (block->tag != DEBUG_HANDLE) {
+    for (size_t ii = 0; ii < block->size / sizeof(float); ++ii) data[ii] = DEBUG_POISON;
+  }
+  block->live = 0;
+  return 1;
+};
+
+#define DEBUG_CHECK(id, param, ptr, tag) if (!debugCheck(id, param, ptr, tag)) return 0
+#define DEBUG_FREE(id, param, ptr, tag) if (!debugFree(id, param, ptr, tag)) return 0
+#define DEBUG_ALLOC(ptr, tag) debugAlloc(ptr, debugSizeOf(tag), tag)
+#define DEBUG_ALLOC_ARRAY(ptr, count, tag) debugAlloc(ptr, (count) * debugSizeOf(tag), DEBUG_ANY)
+
+/**
+ * Returns the amount of live allocations
+ *
+ * @returns {Number} live allocations
+ */
+export int debug(live)() {
+  int count = 0;
+  for (int ii = 0; ii < debugCount; ++ii) count += debugBlocks[ii].live;
+  return count;
+};
+
+/**
+ * Returns the amount of bytes held by live allocations
+ *
+ * @returns {Number} live bytes
+ */
+export int debug(bytes)() {
+  size_t bytes = 0;
+  for (int ii = 0; ii < debugCount; ++ii) {
+    if (debugBlocks[ii].live) bytes += debugBlocks[ii].size;
+  };
+  return bytes;
+};
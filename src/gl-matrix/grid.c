@@ -0,0 +1,286 @@
+#include <webassembly.h>
+#include <math.h>
+#include "common.h"
+
+#define grid(x) grid_##x
+
+/**
+ * Uniform spatial hash grid over points in structure of arrays layout.
+ * The points are sorted by the hash of their cell (counting sort), so
+ * every bucket is a contiguous range of point indices. Different cells
+ * can share a bucket, the queries therefore compare the cell of every
+ * visited point with the cell they are looking at
+ */
+
+typedef struct {
+  float *positions;
+  // bucket ranges into indices, tableSize + 1 entries
+  int *cellStart;
+  int *indices;
+  int *hashes;
+  float *scratch;
+  float cellSize;
+  float invCellSize;
+  int count;
+  int capacity;
+  int tableSize;
+  int scratchSize;
+  // occupied cell range
+  int lo[3];
+  int hi[3];
+} Grid;
+
+int gridCell(Grid *grid, float v) {
+  return (int) floorf(v * grid->invCellSize);
+};
+
+int gridHash(Grid *grid, int x, int y, int z) {
+  unsigned int h = ((unsigned int) x * 73856093) ^ ((unsigned int) y * 19349663) ^ ((unsigned int) z * 83492791);
+  return h & (grid->tableSize - 1);
+};
+
+int gridSameCell(Grid *grid, int index, int x, int y, int z) {
+  float *p = grid->positions;
+  int count = grid->count;
+  return (
+    gridCell(grid, p[index]) == x &&
+    gridCell(grid, p[index + count]) == y &&
+    gridCell(grid, p[index + count * 2]) == z
+  );
+};
+
+// distance in cells from a cell coordinate to the occupied range of an axis
+int gridDistance(Grid *grid, int v, int axis) {
+  if (v < grid->lo[axis]) return grid->lo[axis] - v;
+  if (v > grid->hi[axis]) return v - grid->hi[axis];
+  return 0;
+};
+
+/**
+ * Creates a new, empty grid
+ *
+ * @param {Number} cellSize edge length of the cells, ideally the typical query radius
+ * @returns {grid} a new grid
+ */
+export Grid *grid(create)(float cellSize) {
+  Grid *out = malloc(sizeof(Grid));
+  out->positions = NULL;
+  out->cellStart = NULL;
+  out->indices = NULL;
+  out->hashes = NULL;
+  out->scratch = NULL;
+  out->cellSize = cellSize;
+  out->invCellSize = 1.0 / cellSize;
+  out->count = 0;
+  out->capacity = 0;
+  out->tableSize = 0;
+  out->scratchSize = 0;
+  return out;
+};
+
+/**
+ * Frees a grid
+ */
+export Grid *grid(free)(Grid *grid) {
+  free(grid->cellStart);
+  free(grid->indices);
+  free(grid->hashes);
+  free(grid->scratch);
+  free(grid);
+  return NULL;
+};
+
+/**
+ * Inserts an array of points, replacing the previous ones.
+ * The array is referenced and must stay alive as long as the
+ * grid is queried, after moving the points insert them again
+ *
+ * @param {grid} grid the grid to fill
+ * @param {Float32Array} positions points to insert (SoA)
+ * @param {Number} count amount of points
+ * @returns {grid} grid
+ */
+export Grid *grid(insert)(Grid *grid, float *positions, int count) {
+  if (count > grid->capacity) {
+    free(grid->indices);
+    free(grid->hashes);
+    grid->indices = malloc(count * sizeof(int));
+    grid->hashes = malloc(count * sizeof(int));
+    grid->capacity = count;
+  }
+  int tableSize = 16;
+  while (tableSize < count * 2) tableSize <<= 1;
+  if (tableSize != grid->tableSize) {
+    free(grid->cellStart);
+    grid->cellStart = malloc((tableSize + 1) * sizeof(int));
+    grid->tableSize = tableSize;
+  }
+  grid->positions = positions;
+  grid->count = count;
+  int *start = grid->cellStart;
+  for (int ii = 0; ii <= tableSize; ++ii) start[ii] = 0;
+  for (int axis = 0; axis < 3; ++axis) {
+    grid->lo[axis] = 0;
+    grid->hi[axis] = -1;
+  };
+  for (int ii = 0; ii < count; ++ii) {
+    int x = gridCell(grid, positions[ii]);
+    int y = gridCell(grid, positions[ii + count]);
+    int z = gridCell(grid, positions[ii + count * 2]);
+    if (ii == 0) {
+      grid->lo[0] = grid->hi[0] = x;
+      grid->lo[1] = grid->hi[1] = y;
+      grid->lo[2] = grid->hi[2] = z;
+    }
+    if (x < grid->lo[0]) grid->lo[0] = x; else if (x > grid->hi[0]) grid->hi[0] = x;
+    if (y < grid->lo[1]) grid->lo[1] = y; else if (y > grid->hi[1]) grid->hi[1] = y;
+    if (z < grid->lo[2]) grid->lo[2] = z; else if (z > grid->hi[2]) grid->hi[2] = z;
+    int hash = gridHash(grid, x, y, z);
+    grid->hashes[ii] = hash;
+    start[hash + 1]++;
+  };
+  for (int ii = 0; ii < tableSize; ++ii) start[ii + 1] += start[ii];
+  // scatter, advancing the bucket starts, then shift them back
+  for (int ii = 0; ii < count; ++ii) grid->indices[start[grid->hashes[ii]]++] = ii;
+  for (int ii = tableSize; ii > 0; --ii) start[ii] = start[ii - 1];
+  start[0] = 0;
+  return grid;
+};
+
+/**
+ * Collects the points within a radius
+ *
+ * @param {Int32Array} out receives the point indices
+ * @param {grid} grid the grid to query
+ * @param {vec3} center query center
+ * @param {Number} radius query radius
+ * @param {Number} capacity maximum amount of indices to write
+ * @returns {Number} amount of indices written
+ */
+export int grid(queryRadius)(int *out, Grid *grid, float *center, float radius, int capacity) {
+  float *p = grid->positions;
+  int count = grid->count;
+  int length = 0;
+  float r2 = radius * radius;
+  if (!count) return 0;
+  int x0 = gridCell(grid, center[0] - radius), x1 = gridCell(grid, center[0] + radius);
+  int y0 = gridCell(grid, center[1] - radius), y1 = gridCell(grid, center[1] + radius);
+  int z0 = gridCell(grid, center[2] - radius), z1 = gridCell(grid, center[2] + radius);
+  // clamp to the occupied cells
+  if (x0 < grid->lo[0]) x0 = grid->lo[0];
+  if (y0 < grid->lo[1]) y0 = grid->lo[1];
+  if (z0 < grid->lo[2]) z0 = grid->lo[2];
+  if (x1 > grid->hi[0]) x1 = grid->hi[0];
+  if (y1 > grid->hi[1]) y1 = grid->hi[1];
+  if (z1 > grid->hi[2]) z1 = grid->hi[2];
+  for (int z = z0; z <= z1; ++z) {
+    for (int y = y0; y <= y1; ++y) {
+      for (int x = x0; x <= x1; ++x) {
+        int hash = gridHash(grid, x, y, z);
+        for (int ii = grid->cellStart[hash]; ii < grid->cellStart[hash + 1]; ++ii) {
+          int index = grid->indices[ii];
+          float dx = p[index] - center[0];
+          float dy = p[index + count] - center[1];
+          float dz = p[index + count * 2] - center[2];
+          if (dx * dx + dy * dy + dz * dz > r2) continue;
+          if (!gridSameCell(grid, index, x, y, z)) continue;
+          if (length >= capacity) return length;
+          out[length++] = index;
+        };
+      };
+    };
+  };
+  return length;
+};
+
+/**
+ * Finds the k nearest points of every query point. The cells are
+ * searched in growing shells around the query until no closer point
+ * can follow or the shell covers all occupied cells, so far away queries
+ * and k > count stay bounded. If a query point was inserted itself, it is
+ * its own nearest neighbour. Rows with fewer than k points are filled up
+ * with -1
+ *
+ * @param {Int32Array} out receiving indices, k per query sorted by distance
+ * @param {Float32Array} [outDist] receiving distances, k per query
+ * @param {grid} grid the grid to query
+ * @param {Float32Array} queries query points (SoA)
+ * @param {Number} queryCount amount of query points
+ * @param {Number} k amount of neighbours per query
+ * @returns {Int32Array} out
+ */
+export int *grid(knnArray)(int *out, float *outDist, Grid *grid, float *queries, int queryCount, int k) {
+  float *p = grid->positions;
+  int count = grid->count;
+  if (k > grid->scratchSize) {
+    free(grid->scratch);
+    grid->scratch = malloc(k * sizeof(float));
+    grid->scratchSize = k;
+  }
+  float *dist = grid->scratch;
+  if (k <= 0) return out;
+  for (int qq = 0; qq < queryCount; ++qq) {
+    float qx = queries[qq], qy = queries[qq + queryCount], qz = queries[qq + queryCount * 2];
+    int cx = gridCell(grid, qx), cy = gridCell(grid, qy), cz = gridCell(grid, qz);
+    int *row = out + qq * k;
+    int found = 0;
+    // shells closer than the occupied cells are empty, start at the first one reaching them
+    int r = gridDistance(grid, cx, 0);
+    if (gridDistance(grid, cy, 1) > r) r = gridDistance(grid, cy, 1);
+    if (gridDistance(grid, cz, 2) > r) r = gridDistance(grid, cz, 2);
+    for (; count > 0; ++r) {
+      int z0 = cz - r < grid->lo[2] ? grid->lo[2] - cz : -r;
+      int z1 = cz + r > grid->hi[2] ? grid->hi[2] - cz : r;
+      int y0 = cy - r < grid->lo[1] ? grid->lo[1] - cy : -r;
+      int y1 = cy + r > grid->hi[1] ? grid->hi[1] - cy : r;
+      int x0 = cx - r < grid->lo[0] ? grid->lo[0] - cx : -r;
+      int x1 = cx + r > grid->hi[0] ? grid->hi[0] - cx : r;
+      for (int dz = z0; dz <= z1; ++dz) {
+        int z = cz + dz;
+        for (int dy = y0; dy <= y1; ++dy) {
+          int y = cy + dy;
+          // inside the shell only its two outer cells are visited
+          int step = (r == 0 || dy == -r || dy == r || dz == -r || dz == r) ? 1 : 2 * r;
+          int from = step == 1 ? x0 : -r;
+          int to = step == 1 ? x1 : r;
+          for (int dx = from; dx <= to; dx += step) {
+            int x = cx + dx;
+            if (x < grid->lo[0] || x > grid->hi[0]) continue;
+            int hash = gridHash(grid, x, y, z);
+            for (int ii = grid->cellStart[hash]; ii < grid->cellStart[hash + 1]; ++ii) {
+              int index = grid->indices[ii];
+              float ex = p[index] - qx;
+              float ey = p[index + count] - qy;
+              float ez = p[index + count * 2] - qz;
+              float d2 = ex * ex + ey * ey + ez * ez;
+              if (found == k && d2 >= dist[k - 1]) continue;
+              if (!gridSameCell(grid, index, x, y, z)) continue;
+              // insertion into the sorted row
+              int jj = found < k ? found++ : k - 1;
+              for (; jj > 0 && dist[jj - 1] > d2; --jj) {
+                dist[jj] = dist[jj - 1];
+                row[jj] = row[jj - 1];
+              };
+              dist[jj] = d2;
+              row[jj] = index;
+            };
+          };
+        };
+      };
+      // everything beyond this shell is at least r cells away
+      float reach = r * grid->cellSize;
+      if (found == k && dist[k - 1] <= reach * reach) break;
+      // the shell covers all occupied cells, return what was found
+      if (
+        cx - r <= grid->lo[0] && cx + r >= grid->hi[0] &&
+        cy - r <= grid->lo[1] && cy + r >= grid->hi[1] &&
+        cz - r <= grid->lo[2] && cz + r >= grid->hi[2]
+      ) break;
+    };
+    for (int jj = 0; jj < k; ++jj) {
+      if (jj >= found) row[jj] = -1;
+      if (outDist) outDist[qq * k + jj] = jj < found ? sqrtf(dist[jj]) : INFINITY;
+    };
+  };
+  return out;
+};
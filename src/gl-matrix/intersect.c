@@ -0,0 +1,131 @@
+#include <webassembly.h>
+#include <math.h>
+#include "common.h"
+
+#define intersect(x) intersect_##x
+
+/**
+ * Bulk intersection tests of a single ray against arrays of
+ * primitives. The primitives are passed in structure of arrays
+ * layout (see array.create), the loops are kept branch-light
+ * so they can be vectorized by the compiler
+ */
+
+/**
+ * Finds the nearest axis-aligned bounding box hit by a ray (slab test)
+ *
+ * @param {Float32Array} out receives the distance to the nearest hit
+ * @param {vec3} origin ray origin
+ * @param {vec3} dir ray direction
+ * @param {Float32Array} min box minima (SoA)
+ * @param {Float32Array} max box maxima (SoA)
+ * @param {Number} count amount of boxes
+ * @param {Number} far maximum hit distance
+ * @returns {Number} index of the nearest box or -1
+ */
+export int intersect(rayAabbArray)(float *out, float *origin, float *dir, float *min, float *max, int count, float far) {
+  float inv[VEC_SIZE_3];
+  vec3(inverse)(inv, dir);
+  float ox = origin[0], oy = origin[1], oz = origin[2];
+  float ix = inv[0], iy = inv[1], iz = inv[2];
+  float *minX = min, *minY = min + count, *minZ = min + count * 2;
+  float *maxX = max, *maxY = max + count, *maxZ = max + count * 2;
+  int nearest = -1;
+  float best = far;
+  for (int ii = 0; ii < count; ++ii) {
+    float tx0 = (minX[ii] - ox) * ix, tx1 = (maxX[ii] - ox) * ix;
+    float ty0 = (minY[ii] - oy) * iy, ty1 = (maxY[ii] - oy) * iy;
+    float tz0 = (minZ[ii] - oz) * iz, tz1 = (maxZ[ii] - oz) * iz;
+    float tmin = fmaxf(fmaxf(fminf(tx0, tx1), fminf(ty0, ty1)), fmaxf(fminf(tz0, tz1), 0));
+    float tmax = fminf(fminf(fmaxf(tx0, tx1), fmaxf(ty0, ty1)), fmaxf(tz0, tz1));
+    if (tmin <= tmax && tmin < best) {
+      best = tmin;
+      nearest = ii;
+    }
+  };
+  out[0] = best;
+  return nearest;
+};
+
+/**
+ * Finds the nearest sphere hit by a ray
+ *
+ * @param {Float32Array} out receives the distance to the nearest hit
+ * @param {vec3} origin ray origin
+ * @param {vec3} dir normalized ray direction
+ * @param {Float32Array} centers sphere centers (SoA)
+ * @param {Float32Array} radii sphere radii
+ * @param {Number} count amount of spheres
+ * @param {Number} far maximum hit distance
+ * @returns {Number} index of the nearest sphere or -1
+ */
+export int intersect(raySphereArray)(float *out, float *origin, float *dir, float *centers, float *radii, int count, float far) {
+  float *cx = centers, *cy = centers + count, *cz = centers + count * 2;
+  float center[VEC_SIZE_3];
+  float oc[VEC_SIZE_3];
+  int nearest = -1;
+  float best = far;
+  for (int ii = 0; ii < count; ++ii) {
+    center[0] = cx[ii]; center[1] = cy[ii]; center[2] = cz[ii];
+    vec3(subtract)(oc, origin, center);
+    float b = vec3(dot)(oc, dir);
+    float c = vec3(dot)(oc, oc) - radii[ii] * radii[ii];
+    float disc = b * b - c;
+    if (disc < 0) continue;
+    float sq = sqrtf(disc);
+    // use the far intersection if the origin is inside
+    float t = -b - sq;
+    if (t < 0) t = -b + sq;
+    if (t >= 0 && t < best) {
+      best = t;
+      nearest = ii;
+    }
+  };
+  out[0] = best;
+  return nearest;
+};
+
+/**
+ * Finds the nearest triangle hit by a ray (Möller-Trumbore)
+ *
+ * @param {Float32Array} out receives the distance to the nearest hit
+ * @param {vec3} origin ray origin
+ * @param {vec3} dir ray direction
+ * @param {Float32Array} a first triangle vertices (SoA)
+ * @param {Float32Array} b second triangle vertices (SoA)
+ * @param {Float32Array} c third triangle vertices (SoA)
+ * @param {Number} count amount of triangles
+ * @param {Number} far maximum hit distance
+ * @returns {Number} index of the nearest triangle or -1
+ */
+export int intersect(rayTriangleArray)(float *out, float *origin, float *dir, float *a, float *b, float *c, int count, float far) {
+  float v0[VEC_SIZE_3], v1[VEC_SIZE_3], v2[VEC_SIZE_3];
+  float e1[VEC_SIZE_3], e2[VEC_SIZE_3];
+  float p[VEC_SIZE_3], s[VEC_SIZE_3], q[VEC_SIZE_3];
+  int nearest = -1;
+  float best = far;
+  for (int ii = 0; ii < count; ++ii) {
+    v0[0] = a[ii]; v0[1] = a[ii + count]; v0[2] = a[ii + count * 2];
+    v1[0] = b[ii]; v1[1] = b[ii + count]; v1[2] = b[ii + count * 2];
+    v2[0] = c[ii]; v2[1] = c[ii + count]; v2[2] = c[ii + count * 2];
+    vec3(subtract)(e1, v1, v0);
+    vec3(subtract)(e2, v2, v0);
+    vec3(cross)(p, dir, e2);
+    float det = vec3(dot)(e1, p);
+    if (fabs(det) < EPSILON) continue;
+    float invDet = 1.0 / det;
+    vec3(subtract)(s, origin, v0);
+    float u = vec3(dot)(s, p) * invDet;
+    if (u < 0 || u > 1) continue;
+    vec3(cross)(q, s, e1);
+    float v = vec3(dot)(dir, q) * invDet;
+    if (v < 0 || u + v > 1) continue;
+    float t = vec3(dot)(e2, q) * invDet;
+    if (t >= 0 && t < best) {
+      best = t;
+      nearest = ii;
+    }
+  };
+  out[0] = best;
+  return nearest;
+};
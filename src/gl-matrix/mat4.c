@@ -250,6 +250,94 @@ export float *mat4(transpose)(float *out, float *a) {
   return out;
 };
 
+// set by mat4.rowMajorOutput
+int mat4RowMajor = 0;
+
+/**
+ * Brings a matrix written by an array kernel into the
+ * requested output layout, while it is still in cache
+ */
+void mat4Emit(float *m) {
+  if (mat4RowMajor) mat4(transpose)(m, m);
+};
+
+/**
+ * Makes the matrix array kernels (mat4.modelViewProjectionArray,
+ * including its normal matrices, mat4.cascadeArray and physics.composeArray)
+ * write their matrices row-major, i.e. transposed, so no separate
+ * conversion pass is needed
+ *
+ * @param {Boolean} enabled true for row-major, false for column-major output
+ * @returns {Boolean} the previous setting
+ */
+export int mat4(rowMajorOutput)(int enabled) {
+  int previous = mat4RowMajor;
+  mat4RowMajor = !!enabled;
+  return previous;
+};
+
+/**
+ * Transposes an array of matrices, converting between column-major
+ * and row-major layout. The output may be the input
+ *
+ * @param {Float32Array} out the receiving matrices
+ * @param {Float32Array} a the source matrices
+ * @param {Number} count amount of matrices
+ * @returns {Float32Array} out
+ */
+export float *mat4(transposeArray)(float *out, float *a, int count) {
+  for (int ii = 0; ii < count; ++ii) {
+    mat4(transpose)(out + ii * MAT_SIZE_4, a + ii * MAT_SIZE_4);
+  };
+  return out;
+};
+
+/**
+ * Copies an array of matrices with a single memcpy, which becomes
+ * memory.copy when built with bulk-memory. The arrays must not overlap
+ *
+ * @param {Float32Array} out the receiving matrices
+ * @param {Float32Array} a the source matrices
+ * @param {Number} count amount of matrices
+ * @returns {Float32Array} out
+ */
+export float *mat4(copyArray)(float *out, float *a, int count) {
+  memcpy(out, a, count * MAT_SIZE_4 * sizeof(float));
+  return out;
+};
+
+/**
+ * Sets an array of matrices to the identity matrix. The first matrix
+ * is written once and then doubled by copying, so any count takes
+ * log2(count) copies
+ *
+ * @param {Float32Array} out the receiving matrices
+ * @param {Number} count amount of matrices
+ * @returns {Float32Array} out
+ */
+export float *mat4(identityArray)(float *out, int count) {
+  if (count <= 0) return out;
+  mat4(identity)(out);
+  for (int done = 1; done < count;) {
+    int next = done * 2 < count ? done : count - done;
+    memcpy(out + done * MAT_SIZE_4, out, next * MAT_SIZE_4 * sizeof(float));
+    done += next;
+  };
+  return out;
+};
+
+/**
+ * Creates a new array of matrices initialized with the values of an existing one
+ *
+ * @param {Float32Array} a the source matrices
+ * @param {Number} count amount of matrices
+ * @returns {Float32Array} a new array of matrices
+ */
+export float *mat4(cloneArray)(float *a, int count) {
+  float *out = malloc(count * MAT_SIZE_4 * sizeof(float));
+  return mat4(copyArray)(out, a, count);
+};
+
 /**
  * Inverts a mat4
  *
@@ -484,7 +572,7 @@ export float *mat4(scale)(float *out, float *a, float *v) {
  */
 export float *mat4(rotate)(float *out, float *a, float rad, float *axis) {
   float x = axis[0], y = axis[1], z = axis[2];
-  float len = sqrtf(x * x + y * y + z * z);
+  float len = x * x + y * y + z * z;
   float s, c, t;
   float a00, a01, a02, a03;
   float a10, a11, a12, a13;
@@ -493,15 +581,15 @@ export float *mat4(rotate)(float *out, float *a, float rad, float *axis) {
   float b10, b11, b12;
   float b20, b21, b22;
 
-  if (fabs(len) < EPSILON) { return NULL; }
+  if (len < EPSILON * EPSILON) { return NULL; }
 
-  len = 1.0 / len;
+  len = INVSQRT(len);
   x *= len;
   y *= len;
   z *= len;
 
-  s = sinf(rad);
-  c = cosf(rad);
+  s = SIN(rad);
+  c = COS(rad);
   t = 1 - c;
 
   a00 = a[0]; a01 = a[1]; a02 = a[2]; a03 = a[3];
@@ -545,8 +633,8 @@ export float *mat4(rotate)(float *out, float *a, float rad, float *axis) {
  * @returns {mat4} out
  */
 export float *mat4(rotateX)(float *out, float *a, float rad) {
-  float s = sinf(rad);
-  float c = cosf(rad);
+  float s = SIN(rad);
+  float c = COS(rad);
   float a10 = a[4];
   float a11 = a[5];
   float a12 = a[6];
@@ -588,8 +676,8 @@ export float *mat4(rotateX)(float *out, float *a, float rad) {
  * @returns {mat4} out
  */
 export float *mat4(rotateY)(float *out, float *a, float rad) {
-  float s = sinf(rad);
-  float c = cosf(rad);
+  float s = SIN(rad);
+  float c = COS(rad);
   float a00 = a[0];
   float a01 = a[1];
   float a02 = a[2];
@@ -631,8 +719,8 @@ export float *mat4(rotateY)(float *out, float *a, float rad) {
  * @returns {mat4} out
  */
 export float *mat4(rotateZ)(float *out, float *a, float rad) {
-  float s = sinf(rad);
-  float c = cosf(rad);
+  float s = SIN(rad);
+  float c = COS(rad);
   float a00 = a[0];
   float a01 = a[1];
   float a02 = a[2];
@@ -741,18 +829,18 @@ export float *mat4(fromScaling)(float *out, float *v) {
  */
 export float *mat4(fromRotation)(float *out, float rad, float *axis) {
   float x = axis[0], y = axis[1], z = axis[2];
-  float len = sqrtf(x * x + y * y + z * z);
+  float len = x * x + y * y + z * z;
   float s, c, t;
 
-  if (fabs(len) < EPSILON) { return NULL; }
+  if (len < EPSILON * EPSILON) { return NULL; }
 
-  len = 1.0 / len;
+  len = INVSQRT(len);
   x *= len;
   y *= len;
   z *= len;
 
-  s = sinf(rad);
-  c = cosf(rad);
+  s = SIN(rad);
+  c = COS(rad);
   t = 1 - c;
 
   // Perform rotation-specific matrix multiplication
@@ -787,8 +875,8 @@ export float *mat4(fromRotation)(float *out, float rad, float *axis) {
  * @returns {mat4} out
  */
 export float *mat4(fromXRotation)(float *out, float rad) {
-  float s = sinf(rad);
-  float c = cosf(rad);
+  float s = SIN(rad);
+  float c = COS(rad);
 
   // Perform axis-specific matrix multiplication
   out[0]  = 1;
@@ -822,8 +910,8 @@ export float *mat4(fromXRotation)(float *out, float rad) {
  * @returns {mat4} out
  */
 export float *mat4(fromYRotation)(float *out, float rad) {
-  float s = sinf(rad);
-  float c = cosf(rad);
+  float s = SIN(rad);
+  float c = COS(rad);
 
   // Perform axis-specific matrix multiplication
   out[0]  = c;
@@ -857,8 +945,8 @@ export float *mat4(fromYRotation)(float *out, float rad) {
  * @returns {mat4} out
  */
 export float *mat4(fromZRotation)(float *out, float rad) {
-  float s = sinf(rad);
-  float c = cosf(rad);
+  float s = SIN(rad);
+  float c = COS(rad);
 
   // Perform axis-specific matrix multiplication
   out[0]  = c;
@@ -1020,6 +1108,76 @@ export float *mat4(getRotation)(float *out, float *mat) {
   return out;
 };
 
+/**
+ * Decomposes a transformation matrix into its translation, rotation
+ *  and scaling in a single pass. Unlike getRotation, the scaling is
+ *  divided out of the rotation, so scaled matrices yield a unit
+ *  quaternion. A mirroring matrix gets a negative x scale
+ * @param {vec3} outT Vector to receive the translation component
+ * @param {quat} outQ Quaternion to receive the rotation component
+ * @param {vec3} outS Vector to receive the scaling component
+ * @param {mat4} mat Matrix to be decomposed (input)
+ * @return {quat} outQ
+ */
+export float *mat4(decompose)(float *outT, float *outQ, float *outS, float *mat) {
+  float m11 = mat[0], m12 = mat[1], m13 = mat[2];
+  float m21 = mat[4], m22 = mat[5], m23 = mat[6];
+  float m31 = mat[8], m32 = mat[9], m33 = mat[10];
+
+  float sx = sqrtf(m11 * m11 + m12 * m12 + m13 * m13);
+  float sy = sqrtf(m21 * m21 + m22 * m22 + m23 * m23);
+  float sz = sqrtf(m31 * m31 + m32 * m32 + m33 * m33);
+
+  float det = m11 * (m22 * m33 - m23 * m32) + m12 * (m23 * m31 - m21 * m33) + m13 * (m21 * m32 - m22 * m31);
+  if (det < 0) sx = -sx;
+
+  outT[0] = mat[12];
+  outT[1] = mat[13];
+  outT[2] = mat[14];
+
+  outS[0] = sx;
+  outS[1] = sy;
+  outS[2] = sz;
+
+  float ix = sx ? 1.0 / sx : 0;
+  float iy = sy ? 1.0 / sy : 0;
+  float iz = sz ? 1.0 / sz : 0;
+  m11 *= ix; m12 *= ix; m13 *= ix;
+  m21 *= iy; m22 *= iy; m23 *= iy;
+  m31 *= iz; m32 *= iz; m33 *= iz;
+
+  float trace = m11 + m22 + m33;
+  float S = 0;
+
+  if (trace > 0) {
+    S = sqrtf(trace + 1.0) * 2;
+    outQ[3] = 0.25 * S;
+    outQ[0] = (m23 - m32) / S;
+    outQ[1] = (m31 - m13) / S;
+    outQ[2] = (m12 - m21) / S;
+  } else if ((m11 > m22) & (m11 > m33)) {
+    S = sqrtf(1.0 + m11 - m22 - m33) * 2;
+    outQ[3] = (m23 - m32) / S;
+    outQ[0] = 0.25 * S;
+    outQ[1] = (m12 + m21) / S;
+    outQ[2] = (m31 + m13) / S;
+  } else if (m22 > m33) {
+    S = sqrtf(1.0 + m22 - m11 - m33) * 2;
+    outQ[3] = (m31 - m13) / S;
+    outQ[0] = (m12 + m21) / S;
+    outQ[1] = 0.25 * S;
+    outQ[2] = (m23 + m32) / S;
+  } else {
+    S = sqrtf(1.0 + m33 - m11 - m22) * 2;
+    outQ[3] = (m12 - m21) / S;
+    outQ[0] = (m31 + m13) / S;
+    outQ[1] = (m23 + m32) / S;
+    outQ[2] = 0.25 * S;
+  }
+
+  return outQ;
+};
+
 /**
  * Creates a matrix from a quaternion rotation, vector translation and vector scale
  * This is equivalent to (but much faster than):
@@ -1332,6 +1490,95 @@ export float *mat4(ortho)(float *out, float left, float right, float bottom, flo
   return out;
 };
 
+/**
+ * Generates a perspective projection matrix with the given bounds,
+ * mapping depth to [0, 1] as in WebGPU, Vulkan and Direct3D.
+ * Passing Infinity as far yields an infinite far plane
+ *
+ * @param {mat4} out mat4 frustum matrix will be written into
+ * @param {number} fovy Vertical field of view in radians
+ * @param {number} aspect Aspect ratio. typically viewport width/height
+ * @param {number} near Near bound of the frustum
+ * @param {number} far Far bound of the frustum, can be Infinity
+ * @returns {mat4} out
+ */
+export float *mat4(perspectiveZO)(float *out, float fovy, float aspect, float near, float far) {
+  mat4(perspective)(out, fovy, aspect, near, far);
+  if (far == INFINITY) {
+    out[10] = -1;
+    out[14] = -near;
+  } else {
+    float nf = 1.0 / (near - far);
+    out[10] = far * nf;
+    out[14] = far * near * nf;
+  }
+  return out;
+};
+
+/**
+ * Generates a reversed-z perspective projection matrix with the given bounds,
+ * mapping the near plane to depth 1 and the far plane to depth 0. Together with
+ * a floating point depth buffer this spreads the precision evenly over the distance.
+ * Passing Infinity as far yields an infinite far plane
+ *
+ * @param {mat4} out mat4 frustum matrix will be written into
+ * @param {number} fovy Vertical field of view in radians
+ * @param {number} aspect Aspect ratio. typically viewport width/height
+ * @param {number} near Near bound of the frustum
+ * @param {number} far Far bound of the frustum, can be Infinity
+ * @returns {mat4} out
+ */
+export float *mat4(perspectiveReverseZ)(float *out, float fovy, float aspect, float near, float far) {
+  mat4(perspective)(out, fovy, aspect, near, far);
+  if (far == INFINITY) {
+    out[10] = 0;
+    out[14] = near;
+  } else {
+    float fn = 1.0 / (far - near);
+    out[10] = near * fn;
+    out[14] = far * near * fn;
+  }
+  return out;
+};
+
+/**
+ * Generates a perspective projection matrix with an infinite far plane,
+ * mapping depth to [-1, 1] like {@link mat4.perspective}
+ *
+ * @param {mat4} out mat4 frustum matrix will be written into
+ * @param {number} fovy Vertical field of view in radians
+ * @param {number} aspect Aspect ratio. typically viewport width/height
+ * @param {number} near Near bound of the frustum
+ * @returns {mat4} out
+ */
+export float *mat4(perspectiveInfinite)(float *out, float fovy, float aspect, float near) {
+  mat4(perspective)(out, fovy, aspect, near, near + 1);
+  out[10] = -1;
+  out[14] = -2 * near;
+  return out;
+};
+
+/**
+ * Generates a orthogonal projection matrix with the given bounds,
+ * mapping depth to [0, 1] as in WebGPU, Vulkan and Direct3D
+ *
+ * @param {mat4} out mat4 frustum matrix will be written into
+ * @param {number} left Left bound of the frustum
+ * @param {number} right Right bound of the frustum
+ * @param {number} bottom Bottom bound of the frustum
+ * @param {number} top Top bound of the frustum
+ * @param {number} near Near bound of the frustum
+ * @param {number} far Far bound of the frustum
+ * @returns {mat4} out
+ */
+export float *mat4(orthoZO)(float *out, float left, float right, float bottom, float top, float near, float far) {
+  mat4(ortho)(out, left, right, bottom, top, near, far);
+  float nf = 1.0 / (near - far);
+  out[10] = nf;
+  out[14] = near * nf;
+  return out;
+};
+
 /**
  * Generates a look-at matrix with the given eye position, focal point, and up axis
  *
@@ -1471,6 +1718,67 @@ export float *mat4(targetTo)(float *out, float *eye, float *target, float *up) {
   return out;
 };
 
+/**
+ * Splits a camera frustum into cascades for cascaded shadow maps and fits
+ * an orthogonal light projection around each of them. The split distances
+ * blend between a logarithmic and a uniform distribution (practical split scheme).
+ * The light's depth range of each cascade is extended towards the light
+ * by the cascade's depth, so occluders in front of it still cast shadows
+ *
+ * @param {Float32Array} out receiving light view-projection matrices (mat4)
+ * @param {Float32Array} outSplits receiving far distance of each cascade
+ * @param {mat4} view camera view matrix
+ * @param {vec3} lightDir direction the light shines into
+ * @param {number} fovy Vertical field of view in radians
+ * @param {number} aspect Aspect ratio. typically viewport width/height
+ * @param {number} near Near bound of the camera frustum
+ * @param {number} far Far bound of the camera frustum
+ * @param {number} lambda 1 for logarithmic, 0 for uniform splits
+ * @param {number} count amount of cascades
+ * @returns {Float32Array} out
+ */
+export float *mat4(cascadeArray)(float *out, float *outSplits, float *view, float *lightDir, float fovy, float aspect, float near, float far, float lambda, int count) {
+  float invView[MAT_SIZE_4];
+  float lightView[MAT_SIZE_4];
+  float proj[MAT_SIZE_4];
+  float origin[3] = { 0, 0, 0 };
+  float up[3] = { 0, 1, 0 };
+  float corner[3];
+  mat4(invert)(invView, view);
+  // any up vector not parallel to the light works
+  if (fabsf(lightDir[1]) > 0.99 * vec3(length)(lightDir)) {
+    up[0] = 1;
+    up[1] = 0;
+  }
+  mat4(lookAt)(lightView, origin, lightDir, up);
+  float tanY = tanf(fovy / 2);
+  float tanX = tanY * aspect;
+  float last = near;
+  for (int ii = 0; ii < count; ++ii) {
+    float p = (ii + 1) / (float) count;
+    float split = lambda * near * powf(far / near, p) + (1.0 - lambda) * (near + (far - near) * p);
+    float lo[3] = { INFINITY, INFINITY, INFINITY };
+    float hi[3] = { -INFINITY, -INFINITY, -INFINITY };
+    for (int jj = 0; jj < 8; ++jj) {
+      float d = jj & 4 ? split : last;
+      corner[0] = (jj & 1 ? d : -d) * tanX;
+      corner[1] = (jj & 2 ? d : -d) * tanY;
+      corner[2] = -d;
+      vec3(transformMat4)(corner, corner, invView);
+      vec3(transformMat4)(corner, corner, lightView);
+      vec3(min)(lo, lo, corner);
+      vec3(max)(hi, hi, corner);
+    };
+    float depth = hi[2] - lo[2];
+    mat4(ortho)(proj, lo[0], hi[0], lo[1], hi[1], -hi[2] - depth, -lo[2]);
+    mat4(multiply)(out + ii * MAT_SIZE_4, proj, lightView);
+    mat4Emit(out + ii * MAT_SIZE_4);
+    outSplits[ii] = split;
+    last = split;
+  };
+  return out;
+};
+
 /**
  * Returns a string representation of a mat4
  *
@@ -1620,6 +1928,75 @@ export float *mat4(multiplyScalarAndAdd)(float *out, float *a, float *b, float s
   return out;
 };
 
+/**
+ * Computes the model-view-projection, model-view and normal matrices
+ * for an array of model matrices in a single pass.
+ * The view-projection product is only computed once, the model-view
+ * product only if outMV or outNormal is given
+ *
+ * @param {Float32Array} outMVP receiving model-view-projection matrices (mat4)
+ * @param {Float32Array} [outMV] receiving model-view matrices (mat4), optional
+ * @param {Float32Array} [outNormal] receiving normal matrices (mat3), optional
+ * @param {mat4} proj projection matrix
+ * @param {mat4} view view matrix
+ * @param {Float32Array} models model matrices (mat4)
+ * @param {Number} count amount of model matrices
+ * @returns {Float32Array} outMVP
+ */
+export float *mat4(modelViewProjectionArray)(float *outMVP, float *outMV, float *outNormal, float *proj, float *view, float *models, int count) {
+  float pv[MAT_SIZE_4];
+  float local[MAT_SIZE_4];
+  mat4(multiply)(pv, proj, view);
+  for (int ii = 0; ii < count; ++ii) {
+    float *model = models + ii * MAT_SIZE_4;
+    float *mv = outMV ? outMV + ii * MAT_SIZE_4 : local;
+    mat4(multiply)(outMVP + ii * MAT_SIZE_4, pv, model);
+    mat4Emit(outMVP + ii * MAT_SIZE_4);
+    // the model-view product is only needed for its outputs
+    if (!outMV && !outNormal) continue;
+    mat4(multiply)(mv, view, model);
+    if (!outNormal) {
+      if (outMV) mat4Emit(mv);
+      continue;
+    }
+    // the inverse transpose of the upper 3x3 has the
+    // cross products of the columns as its columns
+    float *n = outNormal + ii * 9;
+    vec3(cross)(n, mv + 4, mv + 8);
+    vec3(cross)(n + 3, mv + 8, mv);
+    vec3(cross)(n + 6, mv, mv + 4);
+    float det = vec3(dot)(mv, n);
+    det = det ? 1.0 / det : 0;
+    for (int jj = 0; jj < 9; ++jj) n[jj] *= det;
+    if (mat4RowMajor) {
+      float swap;
+      swap = n[1]; n[1] = n[3]; n[3] = swap;
+      swap = n[2]; n[2] = n[6]; n[6] = swap;
+      swap = n[5]; n[5] = n[7]; n[7] = swap;
+    }
+    if (outMV) mat4Emit(mv);
+  };
+  return outMVP;
+};
+
+/**
+ * Decomposes an array of transformation matrices, e.g. the joints
+ * of a skeleton, see {@link mat4.decompose}
+ *
+ * @param {Float32Array} outT receiving translations (vec3)
+ * @param {Float32Array} outQ receiving rotations (quat)
+ * @param {Float32Array} outS receiving scalings (vec3)
+ * @param {Float32Array} mats matrices to be decomposed (mat4)
+ * @param {Number} count amount of matrices
+ * @returns {Float32Array} outQ
+ */
+export float *mat4(decomposeArray)(float *outT, float *outQ, float *outS, float *mats, int count) {
+  for (int ii = 0; ii < count; ++ii) {
+    mat4(decompose)(outT + ii * 3, outQ + ii * 4, outS + ii * 3, mats + ii * MAT_SIZE_4);
+  };
+  return outQ;
+};
+
 /**
  * Returns whether or not the matrices have exactly the same elements in the same position (when compared with ===)
  *
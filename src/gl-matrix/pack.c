@@ -0,0 +1,147 @@
+#include <webassembly.h>
+#include <math.h>
+#include "common.h"
+
+#define pack(x) pack_##x
+
+/**
+ * Conversion of float data into compact formats for uploading vertex
+ * and instance buffers. The scalar kernels work on any float array
+ * (vec3, vec4 or SoA data alike), count is the amount of floats.
+ * The output buffers can be allocated with array.create and read
+ * through array.viewU16, array.viewI16, array.viewU8 and array.viewI8
+ */
+
+int packRound(float x) {
+  return (int) (x + (x < 0 ? -0.5 : 0.5));
+};
+
+/**
+ * Converts a float into a half float, rounding to nearest even.
+ * Overflows become infinity, NaNs stay NaN and small values
+ * become half float subnormals
+ */
+unsigned short packHalf(float value) {
+  union { float f; unsigned int u; } v = { value };
+  union { float f; unsigned int u; } denormMagic = { .u = ((127 - 15) + (23 - 10) + 1) << 23 };
+  unsigned int sign = v.u & 0x80000000;
+  unsigned int out = 0;
+  v.u ^= sign;
+  if (v.u >= (127 + 16) << 23) {
+    // infinity or NaN
+    out = v.u > 0x7F800000 ? 0x7E00 : 0x7C00;
+  } else if (v.u < 113 << 23) {
+    // subnormal or zero, the magic add aligns and rounds the mantissa
+    v.f += denormMagic.f;
+    out = v.u - denormMagic.u;
+  } else {
+    unsigned int odd = (v.u >> 13) & 1;
+    // rebias the exponent from 127 to 15
+    v.u -= (127 - 15) << 23;
+    v.u += 0xFFF;
+    v.u += odd;
+    out = v.u >> 13;
+  }
+  return out | (sign >> 16);
+};
+
+/**
+ * Converts floats into half floats (IEEE 754 binary16)
+ *
+ * @param {Uint16Array} out receiving half floats
+ * @param {Float32Array} a the source floats
+ * @param {Number} count amount of floats
+ * @returns {Uint16Array} out
+ */
+export unsigned short *pack(halfArray)(unsigned short *out, float *a, int count) {
+  for (int ii = 0; ii < count; ++ii) out[ii] = packHalf(a[ii]);
+  return out;
+};
+
+/**
+ * Quantizes floats in [-1, 1] into signed normalized bytes,
+ * values outside are clamped
+ *
+ * @param {Int8Array} out receiving bytes
+ * @param {Float32Array} a the source floats
+ * @param {Number} count amount of floats
+ * @returns {Int8Array} out
+ */
+export signed char *pack(snorm8Array)(signed char *out, float *a, int count) {
+  for (int ii = 0; ii < count; ++ii) out[ii] = packRound(fminf(fmaxf(a[ii], -1.0), 1.0) * 127.0);
+  return out;
+};
+
+/**
+ * Quantizes floats in [-1, 1] into signed normalized shorts,
+ * values outside are clamped
+ *
+ * @param {Int16Array} out receiving shorts
+ * @param {Float32Array} a the source floats
+ * @param {Number} count amount of floats
+ * @returns {Int16Array} out
+ */
+export short *pack(snorm16Array)(short *out, float *a, int count) {
+  for (int ii = 0; ii < count; ++ii) out[ii] = packRound(fminf(fmaxf(a[ii], -1.0), 1.0) * 32767.0);
+  return out;
+};
+
+/**
+ * Quantizes floats in [0, 1] into unsigned normalized bytes,
+ * values outside are clamped
+ *
+ * @param {Uint8Array} out receiving bytes
+ * @param {Float32Array} a the source floats
+ * @param {Number} count amount of floats
+ * @returns {Uint8Array} out
+ */
+export unsigned char *pack(unorm8Array)(unsigned char *out, float *a, int count) {
+  for (int ii = 0; ii < count; ++ii) out[ii] = packRound(fminf(fmaxf(a[ii], 0.0), 1.0) * 255.0);
+  return out;
+};
+
+/**
+ * Quantizes floats in [0, 1] into unsigned normalized shorts,
+ * values outside are clamped
+ *
+ * @param {Uint16Array} out receiving shorts
+ * @param {Float32Array} a the source floats
+ * @param {Number} count amount of floats
+ * @returns {Uint16Array} out
+ */
+export unsigned short *pack(unorm16Array)(unsigned short *out, float *a, int count) {
+  for (int ii = 0; ii < count; ++ii) out[ii] = packRound(fminf(fmaxf(a[ii], 0.0), 1.0) * 65535.0);
+  return out;
+};
+
+/**
+ * Encodes unit vectors with the octahedral mapping into two signed
+ * normalized shorts each (4 bytes instead of 12). The vectors are
+ * projected onto an octahedron, whose lower half is folded over the
+ * upper one, which keeps the error nearly uniform over the sphere
+ *
+ * @param {Int16Array} out receiving shorts, 2 per vector
+ * @param {Float32Array} a the source vectors (vec3)
+ * @param {Number} count amount of vectors
+ * @param {Number} stride floats between the vectors, 0 for tightly packed
+ * @returns {Int16Array} out
+ */
+export short *pack(octahedralArray)(short *out, float *a, int count, int stride) {
+  if (!stride) stride = VEC_SIZE_3;
+  for (int ii = 0, jj = 0; ii < count; ++ii, jj += stride) {
+    float x = a[jj], y = a[jj + 1], z = a[jj + 2];
+    float l1 = fabsf(x) + fabsf(y) + fabsf(z);
+    l1 = l1 > 0 ? 1.0 / l1 : 0;
+    x *= l1;
+    y *= l1;
+    if (z < 0) {
+      float fx = (1.0 - fabsf(y)) * (x >= 0 ? 1.0 : -1.0);
+      float fy = (1.0 - fabsf(x)) * (y >= 0 ? 1.0 : -1.0);
+      x = fx;
+      y = fy;
+    }
+    out[ii * 2] = packRound(fminf(fmaxf(x, -1.0), 1.0) * 32767.0);
+    out[ii * 2 + 1] = packRound(fminf(fmaxf(y, -1.0), 1.0) * 32767.0);
+  };
+  return out;
+};
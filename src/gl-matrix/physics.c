@@ -0,0 +1,214 @@
+#include <webassembly.h>
+#include <math.h>
+#include "common.h"
+
+#define physics(x) physics_##x
+
+/**
+ * Integration steps advancing whole particle systems with one call.
+ * The state is passed in structure of arrays layout (see array.create)
+ * and processed one axis at a time, so the inner loops are plain
+ * streams the compiler can vectorize. Damping is given per second,
+ * the velocity is scaled by 1 / (1 + dt * damping) every step
+ */
+
+/**
+ * Advances positions and velocities by one semi-implicit Euler step,
+ * the velocity is updated first and the new velocity moves the position
+ *
+ * @param {Float32Array} positions positions (SoA), updated in place
+ * @param {Float32Array} velocities velocities (SoA), updated in place
+ * @param {Float32Array} [forces] accumulated forces (SoA), none if omitted
+ * @param {Float32Array} [invMasses] inverse masses, 1 if omitted
+ * @param {vec3} gravity acceleration applied to all particles, except those with an inverse mass of 0
+ * @param {Number} damping velocity damping per second
+ * @param {Number} dt time step
+ * @param {Number} count amount of particles
+ * @returns {Float32Array} positions
+ */
+export float *physics(eulerArray)(float *positions, float *velocities, float *forces, float *invMasses, float *gravity, float damping, float dt, int count) {
+  float decay = 1.0 / (1.0 + dt * damping);
+  for (int axis = 0; axis < 3; ++axis) {
+    float *x = positions + count * axis;
+    float *v = velocities + count * axis;
+    float g = gravity[axis] * dt;
+    if (forces) {
+      float *f = forces + count * axis;
+      if (invMasses) {
+        for (int ii = 0; ii < count; ++ii) v[ii] += f[ii] * invMasses[ii] * dt;
+      } else {
+        for (int ii = 0; ii < count; ++ii) v[ii] += f[ii] * dt;
+      }
+    }
+    for (int ii = 0; ii < count; ++ii) {
+      // static bodies (inverse mass 0) don't fall
+      float gi = invMasses && invMasses[ii] == 0 ? 0 : g;
+      float vel = (v[ii] + gi) * decay;
+      v[ii] = vel;
+      x[ii] += vel * dt;
+    };
+  };
+  return positions;
+};
+
+/**
+ * Advances positions by one position Verlet step. The velocity is implied
+ * by the previous positions, which receive the positions before the step
+ *
+ * @param {Float32Array} positions positions (SoA), updated in place
+ * @param {Float32Array} previous positions of the last step (SoA), updated in place
+ * @param {Float32Array} [forces] accumulated forces (SoA), none if omitted
+ * @param {Float32Array} [invMasses] inverse masses, 1 if omitted
+ * @param {vec3} gravity acceleration applied to all particles, except those with an inverse mass of 0
+ * @param {Number} damping velocity damping per second
+ * @param {Number} dt time step
+ * @param {Number} count amount of particles
+ * @returns {Float32Array} positions
+ */
+export float *physics(verletArray)(float *positions, float *previous, float *forces, float *invMasses, float *gravity, float damping, float dt, int count) {
+  float decay = 1.0 / (1.0 + dt * damping);
+  float dt2 = dt * dt;
+  for (int axis = 0; axis < 3; ++axis) {
+    float *x = positions + count * axis;
+    float *p = previous + count * axis;
+    float *f = forces ? forces + count * axis : NULL;
+    float g = gravity[axis] * dt2;
+    for (int ii = 0; ii < count; ++ii) {
+      float a = f ? f[ii] * (invMasses ? invMasses[ii] : 1.0) * dt2 : 0;
+      float gi = invMasses && invMasses[ii] == 0 ? 0 : g;
+      float cur = x[ii];
+      x[ii] = cur + (cur - p[ii]) * decay + gi + a;
+      p[ii] = cur;
+    };
+  };
+  return positions;
+};
+
+/**
+ * Resets the accumulated forces, to be called after every step
+ *
+ * @param {Float32Array} forces forces (SoA)
+ * @param {Number} count amount of particles
+ * @returns {Float32Array} forces
+ */
+export float *physics(clearArray)(float *forces, int count) {
+  for (int ii = 0; ii < count * 3; ++ii) forces[ii] = 0;
+  return forces;
+};
+
+/**
+ * Integrates angular velocities into orientations and renormalizes them.
+ * The quaternions are stored in structure of arrays layout as well,
+ * all x components followed by all y, z and w components
+ *
+ * @param {Float32Array} orientations quaternions (SoA), updated in place
+ * @param {Float32Array} angularVelocities world space angular velocities in radians per second (SoA)
+ * @param {Number} dt time step
+ * @param {Number} count amount of bodies
+ * @returns {Float32Array} orientations
+ */
+export float *physics(integrateRotationArray)(float *orientations, float *angularVelocities, float dt, int count) {
+  float *qx = orientations, *qy = orientations + count, *qz = orientations + count * 2, *qw = orientations + count * 3;
+  float *wx = angularVelocities, *wy = angularVelocities + count, *wz = angularVelocities + count * 2;
+  float h = dt * 0.5;
+  for (int ii = 0; ii < count; ++ii) {
+    float x = qx[ii], y = qy[ii], z = qz[ii], w = qw[ii];
+    float ax = wx[ii] * h, ay = wy[ii] * h, az = wz[ii] * h;
+    // q += 0.5 * dt * (omega, 0) * q
+    float nx = x + ax * w + ay * z - az * y;
+    float ny = y + ay * w + az * x - ax * z;
+    float nz = z + az * w + ax * y - ay * x;
+    float nw = w - ax * x - ay * y - az * z;
+    float len = nx * nx + ny * ny + nz * nz + nw * nw;
+    len = len > 0 ? INVSQRT(len) : 0;
+    qx[ii] = nx * len;
+    qy[ii] = ny * len;
+    qz[ii] = nz * len;
+    qw[ii] = nw * len;
+  };
+  return orientations;
+};
+
+/**
+ * Writes the rotation and scaling part of a body's transform
+ * into the upper 3x3 of a column-major mat4
+ */
+void physicsRotationScale(float *out, float x, float y, float z, float w, float sx, float sy, float sz) {
+  float x2 = x + x, y2 = y + y, z2 = z + z;
+  float xx = x * x2, xy = x * y2, xz = x * z2;
+  float yy = y * y2, yz = y * z2, zz = z * z2;
+  float wx = w * x2, wy = w * y2, wz = w * z2;
+  out[0] = (1 - (yy + zz)) * sx;
+  out[1] = (xy + wz) * sx;
+  out[2] = (xz - wy) * sx;
+  out[4] = (xy - wz) * sy;
+  out[5] = (1 - (xx + zz)) * sy;
+  out[6] = (yz + wx) * sy;
+  out[8] = (xz + wy) * sz;
+  out[9] = (yz - wx) * sz;
+  out[10] = (1 - (xx + yy)) * sz;
+};
+
+/**
+ * Composes the world matrices of rigid bodies from their positions,
+ * orientations and optional scalings, the batched form of
+ * {@link mat4.fromRotationTranslationScale}
+ *
+ * @param {Float32Array} out receiving matrices (mat4)
+ * @param {Float32Array} positions positions (SoA)
+ * @param {Float32Array} orientations quaternions (SoA)
+ * @param {Float32Array} [scales] scalings (SoA), 1 if omitted
+ * @param {Number} count amount of bodies
+ * @returns {Float32Array} out
+ */
+export float *physics(composeArray)(float *out, float *positions, float *orientations, float *scales, int count) {
+  for (int ii = 0; ii < count; ++ii) {
+    float *m = out + ii * MAT_SIZE_4;
+    float sx = 1, sy = 1, sz = 1;
+    if (scales) {
+      sx = scales[ii];
+      sy = scales[ii + count];
+      sz = scales[ii + count * 2];
+    }
+    physicsRotationScale(m, orientations[ii], orientations[ii + count], orientations[ii + count * 2], orientations[ii + count * 3], sx, sy, sz);
+    m[3] = m[7] = m[11] = 0;
+    m[12] = positions[ii];
+    m[13] = positions[ii + count];
+    m[14] = positions[ii + count * 2];
+    m[15] = 1;
+    mat4Emit(m);
+  };
+  return out;
+};
+
+/**
+ * Like {@link physics.composeArray}, but writes packed 3x4 matrices,
+ * stored row by row (12 floats) with the position in the last column
+ *
+ * @param {Float32Array} out receiving 3x4 matrices
+ * @param {Float32Array} positions positions (SoA)
+ * @param {Float32Array} orientations quaternions (SoA)
+ * @param {Float32Array} [scales] scalings (SoA), 1 if omitted
+ * @param {Number} count amount of bodies
+ * @returns {Float32Array} out
+ */
+export float *physics(compose3x4Array)(float *out, float *positions, float *orientations, float *scales, int count) {
+  float m[MAT_SIZE_4];
+  for (int ii = 0; ii < count; ++ii) {
+    float *o = out + ii * 12;
+    float sx = 1, sy = 1, sz = 1;
+    if (scales) {
+      sx = scales[ii];
+      sy = scales[ii + count];
+      sz = scales[ii + count * 2];
+    }
+    physicsRotationScale(m, orientations[ii], orientations[ii + count], orientations[ii + count * 2], orientations[ii + count * 3], sx, sy, sz);
+    for (int row = 0; row < 3; ++row) {
+      o[row * 4 + 0] = m[row];
+      o[row * 4 + 1] = m[row + 4];
+      o[row * 4 + 2] = m[row + 8];
+      o[row * 4 + 3] = positions[ii + count * row];
+    };
+  };
+  return out;
+};
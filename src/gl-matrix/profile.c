@@ -0,0 +1,92 @@
+#include <webassembly.h>
+#include "common.h"
+
+#define profile(x) profile_##x
+
+/**
+ * Runtime of the profiling build. The hooks are
+ * injected around every export by rollup/instrument.js
+ * and expect the generated export table (exports.h)
+ */
+
+import double now();
+
+double profileCalls[EXPORT_COUNT];
+double profileTime[EXPORT_COUNT];
+int profileTiming = 0;
+
+double profileEnter(int id) {
+  profileCalls[id] += 1;
+  return profileTiming ? now() : 0.0;
+};
+
+void profileLeave(int id, double start) {
+  if (profileTiming) profileTime[id] += now() - start;
+};
+
+#define PROFILE_ENTER(id) double profileStart = profileEnter(id)
+#define PROFILE_LEAVE(id) profileLeave(id, profileStart)
+
+/**
+ * Enables or disables the accumulation of elapsed time.
+ * Timing calls into the host clock twice per export call
+ *
+ * @param {Boolean} enabled
+ * @returns {Boolean} enabled
+ */
+export int profile(timing)(int enabled) {
+  profileTiming = !!enabled;
+  return profileTiming;
+};
+
+/**
+ * Resets all counters and timers
+ *
+ * @returns {Number} amount of profiled exports
+ */
+export int profile(reset)() {
+  for (int ii = 0; ii < EXPORT_COUNT; ++ii) {
+    profileCalls[ii] = 0;
+    profileTime[ii] = 0;
+  };
+  return EXPORT_COUNT;
+};
+
+/**
+ * Returns the amount of profiled exports
+ *
+ * @returns {Number} amount of profiled exports
+ */
+export int profile(count)() {
+  return EXPORT_COUNT;
+};
+
+/**
+ * Returns the name of a profiled export
+ *
+ * @param {Number} id export index
+ * @returns {String} null-terminated name
+ */
+export char const *profile(name)(int id) {
+  return exportNames[id];
+};
+
+/**
+ * Returns how often an export got called
+ *
+ * @param {Number} id export index
+ * @returns {Number} call count
+ */
+export double profile(calls)(int id) {
+  return profileCalls[id];
+};
+
+/**
+ * Returns the accumulated time spent inside an export
+ *
+ * @param {Number} id export index
+ * @returns {Number} elapsed time in milliseconds
+ */
+export double profile(time)(int id) {
+  return profileTime[id];
+};
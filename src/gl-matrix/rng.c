@@ -0,0 +1,171 @@
+#include <webassembly.h>
+#include <math.h>
+#include "common.h"
+
+#define rng(x) rng_##x
+
+/**
+ * Seeded pseudo random number generator (xoshiro128**) running
+ * inside WebAssembly. Every stream has its own state, so sequences
+ * are reproducible per seed. The methods taking an optional stream
+ * fall back to the default stream, which also backs randf() and
+ * therefore every *.random method
+ */
+
+typedef struct {
+  unsigned int s[4];
+} Rng;
+
+Rng rngDefault = { { 0x9E3779B9, 0x243F6A88, 0xB7E15162, 0x3C6EF372 } };
+
+unsigned int rngRotl(unsigned int x, int k) {
+  return (x << k) | (x >> (32 - k));
+};
+
+unsigned int rngNext(Rng *rng) {
+  unsigned int *s = rng->s;
+  unsigned int result = rngRotl(s[1] * 5, 7) * 9;
+  unsigned int t = s[1] << 9;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = rngRotl(s[3], 11);
+  return result;
+};
+
+/**
+ * Returns a float in [0, 1) built from the upper 24 bits
+ */
+float rngFloat(Rng *rng) {
+  return (rngNext(rng) >> 8) * (1.0f / 16777216.0f);
+};
+
+float randf() {
+  return rngFloat(&rngDefault);
+};
+
+/**
+ * Expands a seed into a full state (splitmix32),
+ * so similar seeds still yield unrelated streams
+ */
+void rngSeed(Rng *rng, unsigned int seed) {
+  for (int ii = 0; ii < 4; ++ii) {
+    unsigned int z = (seed += 0x9E3779B9);
+    z = (z ^ (z >> 16)) * 0x85EBCA6B;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35;
+    rng->s[ii] = z ^ (z >> 16);
+  };
+};
+
+/**
+ * Creates a new stream
+ *
+ * @param {Number} seed the seed of the stream
+ * @returns {rng} a new stream
+ */
+export Rng *rng(create)(int seed) {
+  Rng *out = malloc(sizeof(Rng));
+  rngSeed(out, seed);
+  return out;
+};
+
+/**
+ * Frees a stream
+ */
+export Rng *rng(free)(Rng *rng) {
+  free(rng);
+  return NULL;
+};
+
+/**
+ * Restarts a stream with the given seed
+ *
+ * @param {rng} [rng] the stream, the default stream if omitted
+ * @param {Number} seed the new seed
+ * @returns {rng} rng
+ */
+export Rng *rng(seed)(Rng *rng, int seed) {
+  rngSeed(rng ? rng : &rngDefault, seed);
+  return rng;
+};
+
+/**
+ * Returns the next random number of a stream
+ *
+ * @param {rng} [rng] the stream, the default stream if omitted
+ * @returns {Number} a number in [0, 1)
+ */
+export float rng(next)(Rng *rng) {
+  return rngFloat(rng ? rng : &rngDefault);
+};
+
+/**
+ * Fills an array with random numbers
+ *
+ * @param {Float32Array} out the receiving array
+ * @param {rng} [rng] the stream, the default stream if omitted
+ * @param {Number} min the lower bound (inclusive)
+ * @param {Number} max the upper bound (exclusive)
+ * @param {Number} count amount of numbers
+ * @returns {Float32Array} out
+ */
+export float *rng(uniformArray)(float *out, Rng *rng, float min, float max, int count) {
+  if (!rng) rng = &rngDefault;
+  float range = max - min;
+  for (int ii = 0; ii < count; ++ii) out[ii] = min + rngFloat(rng) * range;
+  return out;
+};
+
+/**
+ * Generates random points on the surface of a sphere,
+ * the vectorized form of {@link vec3.random}
+ *
+ * @param {Float32Array} out receiving points (SoA)
+ * @param {rng} [rng] the stream, the default stream if omitted
+ * @param {vec3} [center] center of the sphere, the origin if omitted
+ * @param {Number} radius radius of the sphere
+ * @param {Number} count amount of points
+ * @returns {Float32Array} out
+ */
+export float *rng(sphereArray)(float *out, Rng *rng, float *center, float radius, int count) {
+  if (!rng) rng = &rngDefault;
+  float cx = 0, cy = 0, cz = 0;
+  if (center) {
+    cx = center[0];
+    cy = center[1];
+    cz = center[2];
+  }
+  float *x = out, *y = out + count, *z = out + count * 2;
+  for (int ii = 0; ii < count; ++ii) {
+    float r = rngFloat(rng) * 2.0 * PI;
+    float h = rngFloat(rng) * 2.0 - 1.0;
+    float s = SQRT(1.0 - h * h) * radius;
+    x[ii] = cx + COS(r) * s;
+    y[ii] = cy + SIN(r) * s;
+    z[ii] = cz + h * radius;
+  };
+  return out;
+};
+
+/**
+ * Generates random points inside of an axis-aligned box
+ *
+ * @param {Float32Array} out receiving points (SoA)
+ * @param {rng} [rng] the stream, the default stream if omitted
+ * @param {vec3} min box minimum
+ * @param {vec3} max box maximum
+ * @param {Number} count amount of points
+ * @returns {Float32Array} out
+ */
+export float *rng(boxArray)(float *out, Rng *rng, float *min, float *max, int count) {
+  if (!rng) rng = &rngDefault;
+  for (int axis = 0; axis < 3; ++axis) {
+    float lo = min[axis];
+    float range = max[axis] - lo;
+    float *dst = out + count * axis;
+    for (int ii = 0; ii < count; ++ii) dst[ii] = lo + rngFloat(rng) * range;
+  };
+  return out;
+};
@@ -0,0 +1,1092 @@
+// generated by interfaces/generate.js from interfaces/kernels/vec2.js
+#include <webassembly.h>
+#include <math.h>
+#include "common.h"
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
+
+#define vec2(x) vec2_##x
+
+/**
+ * Frees a vec2
+ */
+export float *vec2(free)(float *a) {
+  free(a);
+  return NULL;
+};
+
+/**
+ * Creates a new, empty vec2
+ *
+ * @returns {vec2} a new 2D vector
+ */
+export float *vec2(create)() {
+  float *out = malloc(VEC_SIZE_2 * sizeof(*out));
+  out[0] = 0;
+  out[1] = 0;
+  return out;
+};
+
+/**
+ * Creates a new vec2 initialized with values from an existing vector
+ *
+ * @param {vec2} a vector to clone
+ * @returns {vec2} a new 2D vector
+ */
+export float *vec2(clone)(float *a) {
+  float *out = malloc(VEC_SIZE_2 * sizeof(*out));
+  out[0] = a[0];
+  out[1] = a[1];
+  return out;
+};
+
+/**
+ * Creates a new vec2 initialized with the given values
+ *
+ * @param {Number} x X component
+ * @param {Number} y Y component
+ * @returns {vec2} a new 2D vector
+ */
+export float *vec2(fromValues)(float x, float y) {
+  float *out = malloc(VEC_SIZE_2 * sizeof(*out));
+  out[0] = x;
+  out[1] = y;
+  return out;
+};
+
+/**
+ * Copy the values from one vec2 to another
+ *
+ * @param {vec2} out the receiving vector
+ * @param {vec2} a the source vector
+ * @returns {vec2} out
+ */
+export float *vec2(copy)(float *out, float *a) {
+  out[0] = a[0];
+  out[1] = a[1];
+  return out;
+};
+
+/**
+ * Set the components of a vec2 to the given values
+ *
+ * @param {vec2} out the receiving vector
+ * @param {Number} x X component
+ * @param {Number} y Y component
+ * @returns {vec2} out
+ */
+export float *vec2(set)(float *out, float x, float y) {
+  out[0] = x;
+  out[1] = y;
+  return out;
+};
+
+/**
+ * Adds two vec2's
+ *
+ * @param {vec2} out the receiving vector
+ * @param {vec2} a the first operand
+ * @param {vec2} b the second operand
+ * @returns {vec2} out
+ */
+export float *vec2(add)(float *out, float *a, float *b) {
+  out[0] = a[0] + b[0];
+  out[1] = a[1] + b[1];
+  return out;
+};
+
+/**
+ * Subtracts vector b from vector a
+ *
+ * @param {vec2} out the receiving vector
+ * @param {vec2} a the first operand
+ * @param {vec2} b the second operand
+ * @returns {vec2} out
+ */
+export float *vec2(subtract)(float *out, float *a, float *b) {
+  out[0] = a[0] - b[0];
+  out[1] = a[1] - b[1];
+  return out;
+};
+
+/**
+ * Multiplies two vec2's
+ *
+ * @param {vec2} out the receiving vector
+ * @param {vec2} a the first operand
+ * @param {vec2} b the second operand
+ * @returns {vec2} out
+ */
+export float *vec2(multiply)(float *out, float *a, float *b) {
+  out[0] = a[0] * b[0];
+  out[1] = a[1] * b[1];
+  return out;
+};
+
+/**
+ * Divides two vec2's
+ *
+ * @param {vec2} out the receiving vector
+ * @param {vec2} a the first operand
+ * @param {vec2} b the second operand
+ * @returns {vec2} out
+ */
+export float *vec2(divide)(float *out, float *a, float *b) {
+  out[0] = a[0] / b[0];
+  out[1] = a[1] / b[1];
+  return out;
+};
+
+/**
+ * Math.ceil the components of a vec2
+ *
+ * @param {vec2} out the receiving vector
+ * @param {vec2} a vector to ceil
+ * @returns {vec2} out
+ */
+export float *vec2(ceil)(float *out, float *a) {
+  out[0] = ceilf(a[0]);
+  out[1] = ceilf(a[1]);
+  return out;
+};
+
+/**
+ * Math.floor the components of a vec2
+ *
+ * @param {vec2} out the receiving vector
+ * @param {vec2} a vector to floor
+ * @returns {vec2} out
+ */
+export float *vec2(floor)(float *out, float *a) {
+  out[0] = floorf(a[0]);
+  out[1] = floorf(a[1]);
+  return out;
+};
+
+/**
+ * Returns the minimum of two vec2's
+ *
+ * @param {vec2} out the receiving vector
+ * @param {vec2} a the first operand
+ * @param {vec2} b the second operand
+ * @returns {vec2} out
+ */
+export float *vec2(min)(float *out, float *a, float *b) {
+  out[0] = b[0] < a[0] ? b[0] : a[0];
+  out[1] = b[1] < a[1] ? b[1] : a[1];
+  return out;
+};
+
+/**
+ * Returns the maximum of two vec2's
+ *
+ * @param {vec2} out the receiving vector
+ * @param {vec2} a the first operand
+ * @param {vec2} b the second operand
+ * @returns {vec2} out
+ */
+export float *vec2(max)(float *out, float *a, float *b) {
+  out[0] = a[0] < b[0] ? b[0] : a[0];
+  out[1] = a[1] < b[1] ? b[1] : a[1];
+  return out;
+};
+
+/**
+ * Math.round the components of a vec2
+ *
+ * @param {vec2} out the receiving vector
+ * @param {vec2} a vector to round
+ * @returns {vec2} out
+ */
+export float *vec2(round)(float *out, float *a) {
+  out[0] = roundf(a[0]);
+  out[1] = roundf(a[1]);
+  return out;
+};
+
+/**
+ * Scales a vec2 by a scalar number
+ *
+ * @param {vec2} out the receiving vector
+ * @param {vec2} a the vector to scale
+ * @param {Number} b amount to scale the vector by
+ * @returns {vec2} out
+ */
+export float *vec2(scale)(float *out, float *a, float b) {
+  out[0] = a[0] * b;
+  out[1] = a[1] * b;
+  return out;
+};
+
+/**
+ * Adds two vec2's after scaling the second operand by a scalar value
+ *
+ * @param {vec2} out the receiving vector
+ * @param {vec2} a the first operand
+ * @param {vec2} b the second operand
+ * @param {Number} scale the amount to scale b by before adding
+ * @returns {vec2} out
+ */
+export float *vec2(scaleAndAdd)(float *out, float *a, float *b, float scale) {
+  out[0] = a[0] + (b[0] * scale);
+  out[1] = a[1] + (b[1] * scale);
+  return out;
+};
+
+/**
+ * Calculates the euclidian distance between two vec2's
+ *
+ * @param {vec2} a the first operand
+ * @param {vec2} b the second operand
+ * @returns {Number} distance between a and b
+ */
+export float vec2(distance)(float *a, float *b) {
+  float x = b[0] - a[0];
+  float y = b[1] - a[1];
+  return sqrtf(x * x + y * y);
+};
+
+/**
+ * Calculates the squared euclidian distance between two vec2's
+ *
+ * @param {vec2} a the first operand
+ * @param {vec2} b the second operand
+ * @returns {Number} squared distance between a and b
+ */
+export float vec2(squaredDistance)(float *a, float *b) {
+  float x = b[0] - a[0];
+  float y = b[1] - a[1];
+  return x * x + y * y;
+};
+
+/**
+ * Calculates the length of a vec2
+ *
+ * @param {vec2} a vector to calculate length of
+ * @returns {Number} length of a
+ */
+export float vec2(length)(float *a) {
+  return sqrtf(a[0] * a[0] + a[1] * a[1]);
+};
+
+/**
+ * Calculates the squared length of a vec2
+ *
+ * @param {vec2} a vector to calculate squared length of
+ * @returns {Number} squared length of a
+ */
+export float vec2(squaredLength)(float *a) {
+  return a[0] * a[0] + a[1] * a[1];
+};
+
+/**
+ * Negates the components of a vec2
+ *
+ * @param {vec2} out the receiving vector
+ * @param {vec2} a vector to negate
+ * @returns {vec2} out
+ */
+export float *vec2(negate)(float *out, float *a) {
+  out[0] = -a[0];
+  out[1] = -a[1];
+  return out;
+};
+
+/**
+ * Returns the inverse of the components of a vec2
+ *
+ * @param {vec2} out the receiving vector
+ * @param {vec2} a vector to invert
+ * @returns {vec2} out
+ */
+export float *vec2(inverse)(float *out, float *a) {
+  out[0] = 1.0 / a[0];
+  out[1] = 1.0 / a[1];
+  return out;
+};
+
+/**
+ * Normalize a vec2
+ *
+ * @param {vec2} out the receiving vector
+ * @param {vec2} a vector to normalize
+ * @returns {vec2} out
+ */
+export float *vec2(normalize)(float *out, float *a) {
+  float x = a[0];
+  float y = a[1];
+  float len = x*x + y*y;
+  if (len > 0) {
+    len = INVSQRT(len);
+    out[0] = a[0] * len;
+    out[1] = a[1] * len;
+  }
+  return out;
+};
+
+/**
+ * Calculates the dot product of two vec2's
+ *
+ * @param {vec2} a the first operand
+ * @param {vec2} b the second operand
+ * @returns {Number} dot product of a and b
+ */
+export float vec2(dot)(float *a, float *b) {
+  return a[0] * b[0] + a[1] * b[1];
+};
+
+/**
+ * Computes the cross product of two vec2's
+ * Note that the cross product must by definition produce a 3D vector
+ *
+ * @param {vec3} out the receiving vector
+ * @param {vec2} a the first operand
+ * @param {vec2} b the second operand
+ * @returns {vec3} out
+ */
+export float *vec2(cross)(float *out, float *a, float *b) {
+  float z = a[0] * b[1] - a[1] * b[0];
+  out[0] = out[1] = 0;
+  out[2] = z;
+  return out;
+};
+
+/**
+ * Performs a linear interpolation between two vec2's
+ *
+ * @param {vec2} out the receiving vector
+ * @param {vec2} a the first operand
+ * @param {vec2} b the second operand
+ * @param {Number} t interpolation amount between the two inputs
+ * @returns {vec2} out
+ */
+export float *vec2(lerp)(float *out, float *a, float *b, float t) {
+  out[0] = a[0] + t * (b[0] - a[0]);
+  out[1] = a[1] + t * (b[1] - a[1]);
+  return out;
+};
+
+/**
+ * Generates a random vector with the given scale
+ *
+ * @param {vec2} out the receiving vector
+ * @param {Number} [scale] Length of the resulting vector. If ommitted, a unit vector will be returned
+ * @returns {vec2} out
+ */
+export float *vec2(random)(float *out, float scale) {
+  float r = randf() * 2.0 * PI;
+  out[0] = COS(r) * scale;
+  out[1] = SIN(r) * scale;
+  return out;
+};
+
+/**
+ * Transforms the vec2 with a mat2
+ *
+ * @param {vec2} out the receiving vector
+ * @param {vec2} a the vector to transform
+ * @param {mat2} m matrix to transform with
+ * @returns {vec2} out
+ */
+export float *vec2(transformMat2)(float *out, float *a, float *m) {
+  float x = a[0], y = a[1];
+  out[0] = m[0] * x + m[2] * y;
+  out[1] = m[1] * x + m[3] * y;
+  return out;
+};
+
+/**
+ * Transforms the vec2 with a mat2d
+ *
+ * @param {vec2} out the receiving vector
+ * @param {vec2} a the vector to transform
+ * @param {mat2d} m matrix to transform with
+ * @returns {vec2} out
+ */
+export float *vec2(transformMat2d)(float *out, float *a, float *m) {
+  float x = a[0], y = a[1];
+  out[0] = m[0] * x + m[2] * y + m[4];
+  out[1] = m[1] * x + m[3] * y + m[5];
+  return out;
+};
+
+/**
+ * Transforms the vec2 with a mat3
+ * 3rd vector component is implicitly '1'
+ *
+ * @param {vec2} out the receiving vector
+ * @param {vec2} a the vector to transform
+ * @param {mat3} m matrix to transform with
+ * @returns {vec2} out
+ */
+export float *vec2(transformMat3)(float *out, float *a, float *m) {
+  float x = a[0], y = a[1];
+  out[0] = m[0] * x + m[3] * y + m[6];
+  out[1] = m[1] * x + m[4] * y + m[7];
+  return out;
+};
+
+/**
+ * Transforms the vec2 with a mat4
+ * 3rd vector component is implicitly '0'
+ * 4th vector component is implicitly '1'
+ *
+ * @param {vec2} out the receiving vector
+ * @param {vec2} a the vector to transform
+ * @param {mat4} m matrix to transform with
+ * @returns {vec2} out
+ */
+export float *vec2(transformMat4)(float *out, float *a, float *m) {
+  float x = a[0], y = a[1];
+  out[0] = m[0] * x + m[4] * y + m[12];
+  out[1] = m[1] * x + m[5] * y + m[13];
+  return out;
+};
+
+/**
+ * Returns a string representation of a vector
+ *
+ * @param {vec2} a vector to represent as a string
+ * @returns {String} string representation of the vector
+ */
+export float *vec2(str)(float *a) {
+  return a;
+};
+
+/**
+ * Returns whether or not the vectors exactly have the same elements in the same position (when compared with ===)
+ *
+ * @param {vec2} a The first vector.
+ * @param {vec2} b The second vector.
+ * @returns {Boolean} True if the vectors are equal, false otherwise.
+ */
+export int vec2(exactEquals)(float *a, float *b) {
+  return a[0] == b[0] && a[1] == b[1];
+};
+
+/**
+ * Returns whether or not the vectors have approximately the same elements in the same position.
+ *
+ * @param {vec2} a The first vector.
+ * @param {vec2} b The second vector.
+ * @returns {Boolean} True if the vectors are equal, false otherwise.
+ */
+export int vec2(equals)(float *a, float *b) {
+  float a0 = a[0], a1 = a[1];
+  float b0 = b[0], b1 = b[1];
+  return (fabs(a0 - b0) <= EPSILON*fmaxf(1.0, fmaxf(fabs(a0), fabs(b0))) &&
+          fabs(a1 - b1) <= EPSILON*fmaxf(1.0, fmaxf(fabs(a1), fabs(b1))));
+};
+
+/**
+ * Alias for {@link vec2.length}
+ * @function
+ */
+export float vec2(len)(float *a) {
+  return vec2(length)(a);
+};
+
+/**
+ * Alias for {@link vec2.subtract}
+ * @function
+ */
+export float *vec2(sub)(float *out, float *a, float *b) {
+  return vec2(subtract)(out, a, b);
+};
+
+/**
+ * Alias for {@link vec2.multiply}
+ * @function
+ */
+export float *vec2(mul)(float *out, float *a, float *b) {
+  return vec2(multiply)(out, a, b);
+};
+
+/**
+ * Alias for {@link vec2.divide}
+ * @function
+ */
+export float *vec2(div)(float *out, float *a, float *b) {
+  return vec2(divide)(out, a, b);
+};
+
+/**
+ * Alias for {@link vec2.distance}
+ * @function
+ */
+export float vec2(dist)(float *a, float *b) {
+  return vec2(distance)(a, b);
+};
+
+/**
+ * Alias for {@link vec2.squaredDistance}
+ * @function
+ */
+export float vec2(sqrDist)(float *a, float *b) {
+  return vec2(squaredDistance)(a, b);
+};
+
+/**
+ * Alias for {@link vec2.squaredLength}
+ * @function
+ */
+export float vec2(sqrLen)(float *a) {
+  return vec2(squaredLength)(a);
+};
+
+// generated by rollup/batch.js
+
+/**
+ * Strided array variant of {@link vec2.copy}
+ *
+ * @param {Float32Array} out the receiving buffer
+ * @param {Float32Array} a the source buffer
+ * @param {Number} count amount of elements
+ * @param {Number} stride floats between the elements of all buffers, 0 for tightly packed
+ * @param {Number} offset floats before the first element of all buffers
+ * @returns {Float32Array} out
+ */
+export float *vec2(copyArray)(float *out, float *a, int count, int stride, int offset) {
+  if (!stride) stride = VEC_SIZE_2;
+#ifdef __wasm_simd128__
+  if (stride == VEC_SIZE_2) {
+    int end = offset + count * VEC_SIZE_2;
+    int jj = offset;
+    for (; jj + 4 <= end; jj += 4) {
+      v128_t va = wasm_v128_load(a + jj);
+      wasm_v128_store(out + jj, va);
+    };
+    for (; jj < end; jj += VEC_SIZE_2) vec2(copy)(out + jj, a + jj);
+    return out;
+  }
+#endif
+  for (int ii = 0, jj = offset; ii < count; ++ii, jj += stride) {
+    vec2(copy)(out + jj, a + jj);
+  };
+  return out;
+};
+
+/**
+ * Strided array variant of {@link vec2.add}
+ *
+ * @param {Float32Array} out the receiving buffer
+ * @param {Float32Array} a the source buffer
+ * @param {Float32Array} b the second operand
+ * @param {Number} count amount of elements
+ * @param {Number} stride floats between the elements of all buffers, 0 for tightly packed
+ * @param {Number} offset floats before the first element of all buffers
+ * @returns {Float32Array} out
+ */
+export float *vec2(addArray)(float *out, float *a, float *b, int count, int stride, int offset) {
+  if (!stride) stride = VEC_SIZE_2;
+#ifdef __wasm_simd128__
+  if (stride == VEC_SIZE_2) {
+    int end = offset + count * VEC_SIZE_2;
+    int jj = offset;
+    for (; jj + 4 <= end; jj += 4) {
+      v128_t va = wasm_v128_load(a + jj);
+      v128_t vb = wasm_v128_load(b + jj);
+      wasm_v128_store(out + jj, wasm_f32x4_add(va, vb));
+    };
+    for (; jj < end; jj += VEC_SIZE_2) vec2(add)(out + jj, a + jj, b + jj);
+    return out;
+  }
+#endif
+  for (int ii = 0, jj = offset; ii < count; ++ii, jj += stride) {
+    vec2(add)(out + jj, a + jj, b + jj);
+  };
+  return out;
+};
+
+/**
+ * Strided array variant of {@link vec2.subtract}
+ *
+ * @param {Float32Array} out the receiving buffer
+ * @param {Float32Array} a the source buffer
+ * @param {Float32Array} b the second operand
+ * @param {Number} count amount of elements
+ * @param {Number} stride floats between the elements of all buffers, 0 for tightly packed
+ * @param {Number} offset floats before the first element of all buffers
+ * @returns {Float32Array} out
+ */
+export float *vec2(subtractArray)(float *out, float *a, float *b, int count, int stride, int offset) {
+  if (!stride) stride = VEC_SIZE_2;
+#ifdef __wasm_simd128__
+  if (stride == VEC_SIZE_2) {
+    int end = offset + count * VEC_SIZE_2;
+    int jj = offset;
+    for (; jj + 4 <= end; jj += 4) {
+      v128_t va = wasm_v128_load(a + jj);
+      v128_t vb = wasm_v128_load(b + jj);
+      wasm_v128_store(out + jj, wasm_f32x4_sub(va, vb));
+    };
+    for (; jj < end; jj += VEC_SIZE_2) vec2(subtract)(out + jj, a + jj, b + jj);
+    return out;
+  }
+#endif
+  for (int ii = 0, jj = offset; ii < count; ++ii, jj += stride) {
+    vec2(subtract)(out + jj, a + jj, b + jj);
+  };
+  return out;
+};
+
+/**
+ * Strided array variant of {@link vec2.multiply}
+ *
+ * @param {Float32Array} out the receiving buffer
+ * @param {Float32Array} a the source buffer
+ * @param {Float32Array} b the second operand
+ * @param {Number} count amount of elements
+ * @param {Number} stride floats between the elements of all buffers, 0 for tightly packed
+ * @param {Number} offset floats before the first element of all buffers
+ * @returns {Float32Array} out
+ */
+export float *vec2(multiplyArray)(float *out, float *a, float *b, int count, int stride, int offset) {
+  if (!stride) stride = VEC_SIZE_2;
+#ifdef __wasm_simd128__
+  if (stride == VEC_SIZE_2) {
+    int end = offset + count * VEC_SIZE_2;
+    int jj = offset;
+    for (; jj + 4 <= end; jj += 4) {
+      v128_t va = wasm_v128_load(a + jj);
+      v128_t vb = wasm_v128_load(b + jj);
+      wasm_v128_store(out + jj, wasm_f32x4_mul(va, vb));
+    };
+    for (; jj < end; jj += VEC_SIZE_2) vec2(multiply)(out + jj, a + jj, b + jj);
+    return out;
+  }
+#endif
+  for (int ii = 0, jj = offset; ii < count; ++ii, jj += stride) {
+    vec2(multiply)(out + jj, a + jj, b + jj);
+  };
+  return out;
+};
+
+/**
+ * Strided array variant of {@link vec2.divide}
+ *
+ * @param {Float32Array} out the receiving buffer
+ * @param {Float32Array} a the source buffer
+ * @param {Float32Array} b the second operand
+ * @param {Number} count amount of elements
+ * @param {Number} stride floats between the elements of all buffers, 0 for tightly packed
+ * @param {Number} offset floats before the first element of all buffers
+ * @returns {Float32Array} out
+ */
+export float *vec2(divideArray)(float *out, float *a, float *b, int count, int stride, int offset) {
+  if (!stride) stride = VEC_SIZE_2;
+#ifdef __wasm_simd128__
+  if (stride == VEC_SIZE_2) {
+    int end = offset + count * VEC_SIZE_2;
+    int jj = offset;
+    for (; jj + 4 <= end; jj += 4) {
+      v128_t va = wasm_v128_load(a + jj);
+      v128_t vb = wasm_v128_load(b + jj);
+      wasm_v128_store(out + jj, wasm_f32x4_div(va, vb));
+    };
+    for (; jj < end; jj += VEC_SIZE_2) vec2(divide)(out + jj, a + jj, b + jj);
+    return out;
+  }
+#endif
+  for (int ii = 0, jj = offset; ii < count; ++ii, jj += stride) {
+    vec2(divide)(out + jj, a + jj, b + jj);
+  };
+  return out;
+};
+
+/**
+ * Strided array variant of {@link vec2.ceil}
+ *
+ * @param {Float32Array} out the receiving buffer
+ * @param {Float32Array} a the source buffer
+ * @param {Number} count amount of elements
+ * @param {Number} stride floats between the elements of all buffers, 0 for tightly packed
+ * @param {Number} offset floats before the first element of all buffers
+ * @returns {Float32Array} out
+ */
+export float *vec2(ceilArray)(float *out, float *a, int count, int stride, int offset) {
+  if (!stride) stride = VEC_SIZE_2;
+#ifdef __wasm_simd128__
+  if (stride == VEC_SIZE_2) {
+    int end = offset + count * VEC_SIZE_2;
+    int jj = offset;
+    for (; jj + 4 <= end; jj += 4) {
+      v128_t va = wasm_v128_load(a + jj);
+      wasm_v128_store(out + jj, wasm_f32x4_ceil(va));
+    };
+    for (; jj < end; jj += VEC_SIZE_2) vec2(ceil)(out + jj, a + jj);
+    return out;
+  }
+#endif
+  for (int ii = 0, jj = offset; ii < count; ++ii, jj += stride) {
+    vec2(ceil)(out + jj, a + jj);
+  };
+  return out;
+};
+
+/**
+ * Strided array variant of {@link vec2.floor}
+ *
+ * @param {Float32Array} out the receiving buffer
+ * @param {Float32Array} a the source buffer
+ * @param {Number} count amount of elements
+ * @param {Number} stride floats between the elements of all buffers, 0 for tightly packed
+ * @param {Number} offset floats before the first element of all buffers
+ * @returns {Float32Array} out
+ */
+export float *vec2(floorArray)(float *out, float *a, int count, int stride, int offset) {
+  if (!stride) stride = VEC_SIZE_2;
+#ifdef __wasm_simd128__
+  if (stride == VEC_SIZE_2) {
+    int end = offset + count * VEC_SIZE_2;
+    int jj = offset;
+    for (; jj + 4 <= end; jj += 4) {
+      v128_t va = wasm_v128_load(a + jj);
+      wasm_v128_store(out + jj, wasm_f32x4_floor(va));
+    };
+    for (; jj < end; jj += VEC_SIZE_2) vec2(floor)(out + jj, a + jj);
+    return out;
+  }
+#endif
+  for (int ii = 0, jj = offset; ii < count; ++ii, jj += stride) {
+    vec2(floor)(out + jj, a + jj);
+  };
+  return out;
+};
+
+/**
+ * Strided array variant of {@link vec2.min}
+ *
+ * @param {Float32Array} out the receiving buffer
+ * @param {Float32Array} a the source buffer
+ * @param {Float32Array} b the second operand
+ * @param {Number} count amount of elements
+ * @param {Number} stride floats between the elements of all buffers, 0 for tightly packed
+ * @param {Number} offset floats before the first element of all buffers
+ * @returns {Float32Array} out
+ */
+export float *vec2(minArray)(float *out, float *a, float *b, int count, int stride, int offset) {
+  if (!stride) stride = VEC_SIZE_2;
+#ifdef __wasm_simd128__
+  if (stride == VEC_SIZE_2) {
+    int end = offset + count * VEC_SIZE_2;
+    int jj = offset;
+    for (; jj + 4 <= end; jj += 4) {
+      v128_t va = wasm_v128_load(a + jj);
+      v128_t vb = wasm_v128_load(b + jj);
+      wasm_v128_store(out + jj, wasm_f32x4_pmin(va, vb));
+    };
+    for (; jj < end; jj += VEC_SIZE_2) vec2(min)(out + jj, a + jj, b + jj);
+    return out;
+  }
+#endif
+  for (int ii = 0, jj = offset; ii < count; ++ii, jj += stride) {
+    vec2(min)(out + jj, a + jj, b + jj);
+  };
+  return out;
+};
+
+/**
+ * Strided array variant of {@link vec2.max}
+ *
+ * @param {Float32Array} out the receiving buffer
+ * @param {Float32Array} a the source buffer
+ * @param {Float32Array} b the second operand
+ * @param {Number} count amount of elements
+ * @param {Number} stride floats between the elements of all buffers, 0 for tightly packed
+ * @param {Number} offset floats before the first element of all buffers
+ * @returns {Float32Array} out
+ */
+export float *vec2(maxArray)(float *out, float *a, float *b, int count, int stride, int offset) {
+  if (!stride) stride = VEC_SIZE_2;
+#ifdef __wasm_simd128__
+  if (stride == VEC_SIZE_2) {
+    int end = offset + count * VEC_SIZE_2;
+    int jj = offset;
+    for (; jj + 4 <= end; jj += 4) {
+      v128_t va = wasm_v128_load(a + jj);
+      v128_t vb = wasm_v128_load(b + jj);
+      wasm_v128_store(out + jj, wasm_f32x4_pmax(va, vb));
+    };
+    for (; jj < end; jj += VEC_SIZE_2) vec2(max)(out + jj, a + jj, b + jj);
+    return out;
+  }
+#endif
+  for (int ii = 0, jj = offset; ii < count; ++ii, jj += stride) {
+    vec2(max)(out + jj, a + jj, b + jj);
+  };
+  return out;
+};
+
+/**
+ * Strided array variant of {@link vec2.round}
+ *
+ * @param {Float32Array} out the receiving buffer
+ * @param {Float32Array} a the source buffer
+ * @param {Number} count amount of elements
+ * @param {Number} stride floats between the elements of all buffers, 0 for tightly packed
+ * @param {Number} offset floats before the first element of all buffers
+ * @returns {Float32Array} out
+ */
+export float *vec2(roundArray)(float *out, float *a, int count, int stride, int offset) {
+  if (!stride) stride = VEC_SIZE_2;
+  for (int ii = 0, jj = offset; ii < count; ++ii, jj += stride) {
+    vec2(round)(out + jj, a + jj);
+  };
+  return out;
+};
+
+/**
+ * Strided array variant of {@link vec2.scale}
+ *
+ * @param {Float32Array} out the receiving buffer
+ * @param {Float32Array} a the source buffer
+ * @param {Number} b amount to scale the vector by
+ * @param {Number} count amount of elements
+ * @param {Number} stride floats between the elements of all buffers, 0 for tightly packed
+ * @param {Number} offset floats before the first element of all buffers
+ * @returns {Float32Array} out
+ */
+export float *vec2(scaleArray)(float *out, float *a, float b, int count, int stride, int offset) {
+  if (!stride) stride = VEC_SIZE_2;
+#ifdef __wasm_simd128__
+  if (stride == VEC_SIZE_2) {
+    v128_t vb = wasm_f32x4_splat(b);
+    int end = offset + count * VEC_SIZE_2;
+    int jj = offset;
+    for (; jj + 4 <= end; jj += 4) {
+      v128_t va = wasm_v128_load(a + jj);
+      wasm_v128_store(out + jj, wasm_f32x4_mul(va, vb));
+    };
+    for (; jj < end; jj += VEC_SIZE_2) vec2(scale)(out + jj, a + jj, b);
+    return out;
+  }
+#endif
+  for (int ii = 0, jj = offset; ii < count; ++ii, jj += stride) {
+    vec2(scale)(out + jj, a + jj, b);
+  };
+  return out;
+};
+
+/**
+ * Strided array variant of {@link vec2.scaleAndAdd}
+ *
+ * @param {Float32Array} out the receiving buffer
+ * @param {Float32Array} a the source buffer
+ * @param {Float32Array} b the second operand
+ * @param {Number} scale the amount to scale b by before adding
+ * @param {Number} count amount of elements
+ * @param {Number} stride floats between the elements of all buffers, 0 for tightly packed
+ * @param {Number} offset floats before the first element of all buffers
+ * @returns {Float32Array} out
+ */
+export float *vec2(scaleAndAddArray)(float *out, float *a, float *b, float scale, int count, int stride, int offset) {
+  if (!stride) stride = VEC_SIZE_2;
+#ifdef __wasm_simd128__
+  if (stride == VEC_SIZE_2) {
+    v128_t vscale = wasm_f32x4_splat(scale);
+    int end = offset + count * VEC_SIZE_2;
+    int jj = offset;
+    for (; jj + 4 <= end; jj += 4) {
+      v128_t va = wasm_v128_load(a + jj);
+      v128_t vb = wasm_v128_load(b + jj);
+      wasm_v128_store(out + jj, wasm_f32x4_add(va, wasm_f32x4_mul(vb, vscale)));
+    };
+    for (; jj < end; jj += VEC_SIZE_2) vec2(scaleAndAdd)(out + jj, a + jj, b + jj, scale);
+    return out;
+  }
+#endif
+  for (int ii = 0, jj = offset; ii < count; ++ii, jj += stride) {
+    vec2(scaleAndAdd)(out + jj, a + jj, b + jj, scale);
+  };
+  return out;
+};
+
+/**
+ * Strided array variant of {@link vec2.negate}
+ *
+ * @param {Float32Array} out the receiving buffer
+ * @param {Float32Array} a the source buffer
+ * @param {Number} count amount of elements
+ * @param {Number} stride floats between the elements of all buffers, 0 for tightly packed
+ * @param {Number} offset floats before the first element of all buffers
+ * @returns {Float32Array} out
+ */
+export float *vec2(negateArray)(float *out, float *a, int count, int stride, int offset) {
+  if (!stride) stride = VEC_SIZE_2;
+#ifdef __wasm_simd128__
+  if (stride == VEC_SIZE_2) {
+    int end = offset + count * VEC_SIZE_2;
+    int jj = offset;
+    for (; jj + 4 <= end; jj += 4) {
+      v128_t va = wasm_v128_load(a + jj);
+      wasm_v128_store(out + jj, wasm_f32x4_neg(va));
+    };
+    for (; jj < end; jj += VEC_SIZE_2) vec2(negate)(out + jj, a + jj);
+    return out;
+  }
+#endif
+  for (int ii = 0, jj = offset; ii < count; ++ii, jj += stride) {
+    vec2(negate)(out + jj, a + jj);
+  };
+  return out;
+};
+
+/**
+ * Strided array variant of {@link vec2.inverse}
+ *
+ * @param {Float32Array} out the receiving buffer
+ * @param {Float32Array} a the source buffer
+ * @param {Number} count amount of elements
+ * @param {Number} stride floats between the elements of all buffers, 0 for tightly packed
+ * @param {Number} offset floats before the first element of all buffers
+ * @returns {Float32Array} out
+ */
+export float *vec2(inverseArray)(float *out, float *a, int count, int stride, int offset) {
+  if (!stride) stride = VEC_SIZE_2;
+#ifdef __wasm_simd128__
+  if (stride == VEC_SIZE_2) {
+    int end = offset + count * VEC_SIZE_2;
+    int jj = offset;
+    for (; jj + 4 <= end; jj += 4) {
+      v128_t va = wasm_v128_load(a + jj);
+      wasm_v128_store(out + jj, wasm_f32x4_div(wasm_f32x4_splat(1.0), va));
+    };
+    for (; jj < end; jj += VEC_SIZE_2) vec2(inverse)(out + jj, a + jj);
+    return out;
+  }
+#endif
+  for (int ii = 0, jj = offset; ii < count; ++ii, jj += stride) {
+    vec2(inverse)(out + jj, a + jj);
+  };
+  return out;
+};
+
+/**
+ * Strided array variant of {@link vec2.normalize}
+ *
+ * @param {Float32Array} out the receiving buffer
+ * @param {Float32Array} a the source buffer
+ * @param {Number} count amount of elements
+ * @param {Number} stride floats between the elements of all buffers, 0 for tightly packed
+ * @param {Number} offset floats before the first element of all buffers
+ * @returns {Float32Array} out
+ */
+export float *vec2(normalizeArray)(float *out, float *a, int count, int stride, int offset) {
+  if (!stride) stride = VEC_SIZE_2;
+  for (int ii = 0, jj = offset; ii < count; ++ii, jj += stride) {
+    vec2(normalize)(out + jj, a + jj);
+  };
+  return out;
+};
+
+/**
+ * Strided array variant of {@link vec2.lerp}
+ *
+ * @param {Float32Array} out the receiving buffer
+ * @param {Float32Array} a the source buffer
+ * @param {Float32Array} b the second operand
+ * @param {Number} t interpolation amount between the two inputs
+ * @param {Number} count amount of elements
+ * @param {Number} stride floats between the elements of all buffers, 0 for tightly packed
+ * @param {Number} offset floats before the first element of all buffers
+ * @returns {Float32Array} out
+ */
+export float *vec2(lerpArray)(float *out, float *a, float *b, float t, int count, int stride, int offset) {
+  if (!stride) stride = VEC_SIZE_2;
+#ifdef __wasm_simd128__
+  if (stride == VEC_SIZE_2) {
+    v128_t vt = wasm_f32x4_splat(t);
+    int end = offset + count * VEC_SIZE_2;
+    int jj = offset;
+    for (; jj + 4 <= end; jj += 4) {
+      v128_t va = wasm_v128_load(a + jj);
+      v128_t vb = wasm_v128_load(b + jj);
+      wasm_v128_store(out + jj, wasm_f32x4_add(va, wasm_f32x4_mul(vt, wasm_f32x4_sub(vb, va))));
+    };
+    for (; jj < end; jj += VEC_SIZE_2) vec2(lerp)(out + jj, a + jj, b + jj, t);
+    return out;
+  }
+#endif
+  for (int ii = 0, jj = offset; ii < count; ++ii, jj += stride) {
+    vec2(lerp)(out + jj, a + jj, b + jj, t);
+  };
+  return out;
+};
+
+/**
+ * Strided array variant of {@link vec2.transformMat2}
+ *
+ * @param {Float32Array} out the receiving buffer
+ * @param {Float32Array} a the source buffer
+ * @param {mat2} m matrix to transform with
+ * @param {Number} count amount of elements
+ * @param {Number} stride floats between the elements of all buffers, 0 for tightly packed
+ * @param {Number} offset floats before the first element of all buffers
+ * @returns {Float32Array} out
+ */
+export float *vec2(transformMat2Array)(float *out, float *a, float *m, int count, int stride, int offset) {
+  if (!stride) stride = VEC_SIZE_2;
+  for (int ii = 0, jj = offset; ii < count; ++ii, jj += stride) {
+    vec2(transformMat2)(out + jj, a + jj, m);
+  };
+  return out;
+};
+
+/**
+ * Strided array variant of {@link vec2.transformMat2d}
+ *
+ * @param {Float32Array} out the receiving buffer
+ * @param {Float32Array} a the source buffer
+ * @param {mat2d} m matrix to transform with
+ * @param {Number} count amount of elements
+ * @param {Number} stride floats between the elements of all buffers, 0 for tightly packed
+ * @param {Number} offset floats before the first element of all buffers
+ * @returns {Float32Array} out
+ */
+export float *vec2(transformMat2dArray)(float *out, float *a, float *m, int count, int stride, int offset) {
+  if (!stride) stride = VEC_SIZE_2;
+  for (int ii = 0, jj = offset; ii < count; ++ii, jj += stride) {
+    vec2(transformMat2d)(out + jj, a + jj, m);
+  };
+  return out;
+};
+
+/**
+ * Strided array variant of {@link vec2.transformMat3}
+ *
+ * @param {Float32Array} out the receiving buffer
+ * @param {Float32Array} a the source buffer
+ * @param {mat3} m matrix to transform with
+ * @param {Number} count amount of elements
+ * @param {Number} stride floats between the elements of all buffers, 0 for tightly packed
+ * @param {Number} offset floats before the first element of all buffers
+ * @returns {Float32Array} out
+ */
+export float *vec2(transformMat3Array)(float *out, float *a, float *m, int count, int stride, int offset) {
+  if (!stride) stride = VEC_SIZE_2;
+  for (int ii = 0, jj = offset; ii < count; ++ii, jj += stride) {
+    vec2(transformMat3)(out + jj, a + jj, m);
+  };
+  return out;
+};
+
+/**
+ * Strided array variant of {@link vec2.transformMat4}
+ *
+ * @param {Float32Array} out the receiving buffer
+ * @param {Float32Array} a the source buffer
+ * @param {mat4} m matrix to transform with
+ * @param {Number} count amount of elements
+ * @param {Number} stride floats between the elements of all buffers, 0 for tightly packed
+ * @param {Number} offset floats before the first element of all buffers
+ * @returns {Float32Array} out
+ */
+export float *vec2(transformMat4Array)(float *out, float *a, float *m, int count, int stride, int offset) {
+  if (!stride) stride = VEC_SIZE_2;
+  for (int ii = 0, jj = offset; ii < count; ++ii, jj += stride) {
+    vec2(transformMat4)(out + jj, a + jj, m);
+  };
+  return out;
+};
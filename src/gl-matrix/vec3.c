@@ -343,8 +343,7 @@ export float *vec3(normalize)(float *out, float *a) {
   float z = a[2];
   float len = x*x + y*y + z*z;
   if (len > 0) {
-    //TODO: evaluate use of glm_invsqrt here?
-    len = 1 / sqrtf(len);
+    len = INVSQRT(len);
     out[0] = a[0] * len;
     out[1] = a[1] * len;
     out[2] = a[2] * len;
@@ -457,9 +456,9 @@ export float *vec3(bezier)(float *out, float *a, float *b, float *c, float *d, f
 export float *vec3(random)(float *out, float scale) {
   float r = randf() * 2.0 * PI;
   float z = (randf() * 2.0) - 1.0;
-  float zScale = sqrtf(1.0-z*z) * scale;
-  out[0] = cosf(r) * zScale;
-  out[1] = sinf(r) * zScale;
+  float zScale = SQRT(1.0-z*z) * scale;
+  out[0] = COS(r) * zScale;
+  out[1] = SIN(r) * zScale;
   out[2] = z * scale;
   return out;
 };
@@ -601,8 +600,8 @@ export float *vec3(rotateZ)(float *out, float *a, float *b, float c) {
   return out;
 };
 
-float aH0[VEC_SIZE_3] = { 0.0, 0.0, 0.0 };
-float aH1[VEC_SIZE_3] = { 0.0, 0.0, 0.0 };
+float aH0[3] = { 0.0, 0.0, 0.0 };
+float aH1[3] = { 0.0, 0.0, 0.0 };
 /**
  * Get the angle between two 3D vectors
  * @param {vec3} a The first operand
@@ -368,7 +368,7 @@ export float *vec4(normalize)(float *out, float *a) {
   float w = a[3];
   float len = x*x + y*y + z*z + w*w;
   if (len > 0) {
-    len = 1 / sqrtf(len);
+    len = INVSQRT(len);
     out[0] = x * len;
     out[1] = y * len;
     out[2] = z * len;
@@ -469,6 +469,91 @@ export float *vec4(transformQuat)(float *out, float *a, float *q) {
   return out;
 };
 
+// clip plane bits of vec4.projectArray
+#define OUTCODE_LEFT 1
+#define OUTCODE_RIGHT 2
+#define OUTCODE_BOTTOM 4
+#define OUTCODE_TOP 8
+#define OUTCODE_NEAR 16
+#define OUTCODE_FAR 32
+
+int vec4Project(float *out, int *outcodes, float *a, float *m, float *viewport, int count, int stride, int zeroToOne) {
+  float vx = viewport[0], vy = viewport[1];
+  float hw = viewport[2] * 0.5, hh = viewport[3] * 0.5;
+  int shared = count > 0 ? 63 : 0;
+  if (!stride) stride = VEC_SIZE_3;
+  for (int ii = 0; ii < count; ++ii) {
+    float *p = a + ii * stride;
+    float *o = out + ii * VEC_SIZE_4;
+    float x = p[0], y = p[1], z = p[2];
+    float cx = m[0] * x + m[4] * y + m[8] * z + m[12];
+    float cy = m[1] * x + m[5] * y + m[9] * z + m[13];
+    float cz = m[2] * x + m[6] * y + m[10] * z + m[14];
+    float cw = m[3] * x + m[7] * y + m[11] * z + m[15];
+    // clip space depth starts at -w, or at 0 for [0, 1] projections
+    float cn = zeroToOne ? 0 : -cw;
+    int code = (
+      (cx < -cw) * OUTCODE_LEFT | (cx > cw) * OUTCODE_RIGHT |
+      (cy < -cw) * OUTCODE_BOTTOM | (cy > cw) * OUTCODE_TOP |
+      (cz < cn) * OUTCODE_NEAR | (cz > cw) * OUTCODE_FAR
+    );
+    if (outcodes) outcodes[ii] = code;
+    shared &= code;
+    float iw = cw != 0 ? 1.0 / cw : 0;
+    o[0] = vx + (cx * iw + 1.0) * hw;
+    o[1] = vy + (cy * iw + 1.0) * hh;
+    o[2] = zeroToOne ? cz * iw : (cz * iw + 1.0) * 0.5;
+    o[3] = iw;
+  };
+  return shared;
+};
+
+/**
+ * Projects an array of points to the screen in one pass: transforms them
+ * (w = 1) into clip space, classifies them against the clip planes,
+ * divides by w and maps the result into the viewport. Every point yields
+ * a vec4 of window x, window y (upwards, like gl_FragCoord), depth in [0, 1]
+ * and 1/w for perspective correct interpolation.
+ * The outcodes have a bit set for every plane the point is outside of
+ * (1 left, 2 right, 4 bottom, 8 top, 16 near, 32 far), points
+ * behind the camera are flagged near and have no meaningful position.
+ * Expects clip space depth in [-1, 1] as produced by {@link mat4.perspective},
+ * {@link mat4.ortho} and {@link mat4.perspectiveInfinite}, use
+ * {@link vec4.projectArrayZO} for the [0, 1] projections
+ *
+ * @param {Float32Array} out receiving screen space points (vec4)
+ * @param {Int32Array} [outcodes] receiving outcodes, one per point
+ * @param {Float32Array} a points to project (vec3)
+ * @param {mat4} m view-projection matrix
+ * @param {vec4} viewport x, y, width and height of the viewport
+ * @param {Number} count amount of points
+ * @param {Number} stride floats between the points, 0 for tightly packed
+ * @returns {Number} the outcode bits shared by all points, if any is set all of them are outside the same plane
+ */
+export int vec4(projectArray)(float *out, int *outcodes, float *a, float *m, float *viewport, int count, int stride) {
+  return vec4Project(out, outcodes, a, m, viewport, count, stride, 0);
+};
+
+/**
+ * Same as {@link vec4.projectArray} for projections with clip space
+ * depth in [0, 1] ({@link mat4.perspectiveZO}, {@link mat4.orthoZO} and
+ * {@link mat4.perspectiveReverseZ}). The depth is written unchanged. With
+ * reverse-Z the planes swap: points in front of the near plane or behind
+ * the camera get the far bit, points beyond the far plane the near bit
+ *
+ * @param {Float32Array} out receiving screen space points (vec4)
+ * @param {Int32Array} [outcodes] receiving outcodes, one per point
+ * @param {Float32Array} a points to project (vec3)
+ * @param {mat4} m view-projection matrix
+ * @param {vec4} viewport x, y, width and height of the viewport
+ * @param {Number} count amount of points
+ * @param {Number} stride floats between the points, 0 for tightly packed
+ * @returns {Number} the outcode bits shared by all points, if any is set all of them are outside the same plane
+ */
+export int vec4(projectArrayZO)(float *out, int *outcodes, float *a, float *m, float *viewport, int count, int stride) {
+  return vec4Project(out, outcodes, a, m, viewport, count, stride, 1);
+};
+
 /**
  * Returns a string representation of a vector
  *
@@ -1,17 +1,38 @@
 import {
   load,
+  loadNative,
   imports
 } from "./utils";
 
 import module from "./module.js";
+import generated from "./generated.js";
 
 import vec3_bridge from "./gl-matrix/bridges/vec3.js";
 import vec4_bridge from "./gl-matrix/bridges/vec4.js";
 import mat4_bridge from "./gl-matrix/bridges/mat4.js";
+import array_bridge from "./gl-matrix/bridges/array.js";
+import profile_bridge from "./gl-matrix/bridges/profile.js";
+import debug_bridge from "./gl-matrix/bridges/debug.js";
+import snapshot_bridge from "./gl-matrix/bridges/snapshot.js";
+import stream_bridge from "./gl-matrix/bridges/stream.js";
 
 let vec3 = {};
 let vec4 = {};
 let mat4 = {};
+let array = {};
+let intersect = {};
+let aabb = {};
+let bvh = {};
+let billboard = {};
+let rng = {};
+let grid = {};
+let physics = {};
+let pack = {};
+let codec = {};
+let profile = {};
+let debug = {};
+let snapshot = {};
+let stream = {};
 
 function validateEnvironment() {
   if (typeof WebAssembly === "undefined") {
@@ -19,13 +40,37 @@ function validateEnvironment() {
   }
 };
 
-function init() {
+/**
+ * @param {Object} [options]
+ * @param {Object} [options.native] the loaded N-API addon, replaces WebAssembly
+ * @param {Number} [options.heapSize] heap size of the addon in bytes
+ */
+function init(options = {}) {
   return new Promise(resolve => {
-    validateEnvironment();
-    load(module, imports).then(instance => {
+    if (!options.native) validateEnvironment();
+    let loading = options.native ? loadNative(options.native, options) : load(module, imports);
+    loading.then(instance => {
       createLinks(vec3, "vec3", instance);
       createLinks(vec4, "vec4", instance);
       createLinks(mat4, "mat4", instance);
+      createLinks(array, "array", instance);
+      createLinks(intersect, "intersect", instance);
+      createLinks(aabb, "aabb", instance);
+      createLinks(bvh, "bvh", instance);
+      createLinks(billboard, "billboard", instance);
+      createLinks(rng, "rng", instance);
+      createLinks(grid, "grid", instance);
+      createLinks(physics, "physics", instance);
+      createLinks(pack, "pack", instance);
+      createLinks(codec, "codec", instance);
+      createLinks(profile, "profile", instance);
+      createLinks(debug, "debug", instance);
+      createLinks(snapshot, "snapshot", instance);
+      createLinks(stream, "stream", instance);
+      generated.map(entry => {
+        createLinks(entry.module, entry.name, instance);
+        entry.bridge(entry.module, instance.memory);
+      });
       resolve(true);
     });
   });
@@ -52,6 +97,11 @@ function createLinks(module, name, instance) {
     case "vec3": vec3_bridge(module, memory); break;
     case "vec4": vec4_bridge(module, memory); break;
     case "mat4": mat4_bridge(module, memory); break;
+    case "array": array_bridge(module, memory); break;
+    case "profile": profile_bridge(module, memory); break;
+    case "debug": debug_bridge(module, memory); break;
+    case "snapshot": snapshot_bridge(module, memory); break;
+    case "stream": stream_bridge(module, memory, array, vec3); break;
   };
 };
 
@@ -59,5 +109,21 @@ export {
   init,
   vec3,
   vec4,
-  mat4
+  mat4,
+  array,
+  intersect,
+  aabb,
+  bvh,
+  billboard,
+  rng,
+  grid,
+  physics,
+  pack,
+  codec,
+  profile,
+  debug,
+  snapshot,
+  stream
 };
+
+export * from "./generated.js";
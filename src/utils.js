@@ -1,12 +1,51 @@
 export let imports = {
   initialMemory: 0,
   imports: {
-    randf: () => Math.random(),
+    now: typeof performance !== "undefined" ? () => performance.now() : () => Date.now(),
     printi: console.log.bind(console),
     printch: (cc) => console.log(String.fromCharCode(cc))
   }
 };
 
+const NATIVE_HEAP_SIZE = 256 * 1024 * 1024;
+
+const DEBUG_REASONS = [
+  null,
+  "unknown address",
+  "use after free",
+  "wrong type",
+  "out of bounds"
+];
+
+export function readString(memory, address) {
+  let out = "";
+  while (memory.U8[address] !== 0) out += String.fromCharCode(memory.U8[address++]);
+  return out;
+};
+
+/**
+ * FNV-1a hash, identifies the build a snapshot was taken with
+ */
+export function fingerprint(bytes) {
+  let hash = 0x811C9DC5;
+  for (let ii = 0; ii < bytes.length; ++ii) {
+    hash ^= bytes[ii];
+    hash = Math.imul(hash, 0x01000193);
+  };
+  return hash >>> 0;
+};
+
+export function createViews(memory) {
+  let buffer = memory.buffer;
+  memory.I8 = new Int8Array(buffer);
+  memory.U8 = new Uint8Array(buffer);
+  memory.I16 = new Int16Array(buffer);
+  memory.U16 = new Uint16Array(buffer);
+  memory.I32 = new Int32Array(buffer);
+  memory.F32 = new Float32Array(buffer);
+  memory.F64 = new Float64Array(buffer);
+};
+
 export function load(buffer, options = {}) {
 
   let imports = options.imports || {};
@@ -22,13 +61,14 @@ export function load(buffer, options = {}) {
   if (!table) table = new WebAssembly.Table({ initial: 0, element: "anyfunc" });
 
   function grow() {
-    let buffer = memory.buffer;
-    memory.F32 = new Float32Array(buffer);
-    memory.F64 = new Float64Array(buffer);
+    createViews(memory);
   };
 
   grow();
 
+  memory.update = grow;
+  memory.fingerprint = fingerprint(new Uint8Array(buffer));
+
   let env = {};
   env.memoryBase = imports.memoryBase || 0;
   env.memory = memory;
@@ -42,9 +82,23 @@ export function load(buffer, options = {}) {
 
   env._grow = grow;
 
+  env.debugViolation = (name, param, reason, address) => {
+    name = readString(memory, name);
+    param = readString(memory, param);
+    throw Error(`${name}: ${DEBUG_REASONS[reason]} of argument '${param}' at address ${address >>> 0}`);
+  };
+
   return WebAssembly.instantiate(buffer, { env: env })
   .then(module => {
     var instance = module.instance;
+    // modules built with clang define and export their own memory
+    let exported = instance.exports.memory;
+    if (exported instanceof WebAssembly.Memory && exported !== memory) {
+      exported.update = grow;
+      exported.fingerprint = memory.fingerprint;
+      memory = exported;
+      grow();
+    }
     instance.imports = imports;
     instance.memory = memory;
     instance.env = env;
@@ -52,3 +106,23 @@ export function load(buffer, options = {}) {
   });
 
 };
+
+/**
+ * Loads the N-API backend (see rollup/compile.native.js) in place of the
+ * WebAssembly module. Its heap has a fixed size and is exposed as one
+ * ArrayBuffer, addresses are offsets into it just like in WebAssembly
+ */
+export function loadNative(addon, options = {}) {
+  let memory = {
+    buffer: addon.init(options.heapSize || NATIVE_HEAP_SIZE),
+    fingerprint: addon.fingerprint,
+    grow: () => { throw new Error(`The native heap cannot grow`); }
+  };
+  memory.update = () => createViews(memory);
+  memory.update();
+  let exports = {};
+  Object.keys(addon).forEach(key => {
+    if (key !== "init" && key !== "fingerprint") exports[key] = addon[key];
+  });
+  return Promise.resolve({ exports, memory });
+};